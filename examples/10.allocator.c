@@ -0,0 +1,55 @@
+#include <stdio.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Position {
+    float x, y;
+} Position;
+typedef struct Hitpoint {
+    float value;
+} Hitpoint;
+
+int main()
+{
+    // Long running world that reuse freed memory by size class
+    secs_pool pool = {0};
+    secs_pool_init(&pool);
+
+    secs_world world = {0};
+    init_world_with_allocator(&world, secs_pool_allocator(&pool));
+
+    const int POSITION_ID = REGISTER_COMPONENT(&world, Position);
+    const int HITPOINT_ID = REGISTER_COMPONENT(&world, Hitpoint);
+
+    for (int i = 0; i < 100; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        insert_comp(&world, id, POSITION_ID, &(Position) {.x = i, .y = i });
+        insert_comp(&world, id, HITPOINT_ID, &(Hitpoint) { .value = 100.f });
+    }
+    printf("Pool world memory: %zu bytes\n", secs_world_memory_usage(&world));
+
+    // Short lived world for simulation, there is no need to free the world
+    // because the whole thing is thrown away by resetting the arena
+    secs_arena arena = {0};
+    secs_arena_init(&arena, NULL, 1024 * 1024);
+    for (int frame = 0; frame < 3; frame++) {
+        secs_world temp = {0};
+        init_world_with_allocator(&temp, secs_arena_allocator(&arena));
+        const int TEMP_POSITION_ID = REGISTER_COMPONENT(&temp, Position);
+
+        for (int i = 0; i < 1000; i++) {
+            secs_entity_id id = secs_spawn(&temp);
+            insert_comp(&temp, id, TEMP_POSITION_ID, &(Position) {.x = i, .y = frame });
+        }
+        printf("Arena world memory: %zu bytes, arena used: %zu bytes\n", secs_world_memory_usage(&temp), arena.used);
+        secs_arena_reset(&arena);
+    }
+    secs_arena_free(&arena);
+
+    secs_free_world(&world);
+    secs_pool_free(&pool);
+
+    return 0;
+}
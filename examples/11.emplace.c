@@ -0,0 +1,45 @@
+#include <stdio.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Inventory {
+    int items[256];
+    int count;
+} Inventory;
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    const int INVENTORY_ID = REGISTER_COMPONENT(&world, Inventory);
+
+    // Initialize the component in place instead of building it on the stack and copying it
+    secs_entity_id player = secs_spawn(&world);
+    Inventory* inventory = emplace_comp(&world, player, INVENTORY_ID);
+    inventory->count = 1;
+    inventory->items[0] = 69;
+
+    // Or attach it to many entity at once and get contiguous slot back
+    secs_entity_id chests[16];
+    for (int i = 0; i < 16; i++) {
+        chests[i] = secs_spawn(&world);
+    }
+    Inventory* loot = emplace_comp_many(&world, chests, 16, INVENTORY_ID);
+    for (int i = 0; i < 16; i++) {
+        loot[i].count = 1;
+        loot[i].items[0] = i;
+    }
+
+    secs_query_iterator it = query_iter(&world, CREATE_QUERY(.has = INVENTORY_ID));
+    while (query_iter_next(&it)) {
+        Inventory* inv = field(&it, INVENTORY_ID);
+        printf("Entity ID: %zu - first item: %d\n", query_iter_current(&it), inv->items[0]);
+    }
+
+    secs_free_world(&world);
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <stddef.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct NetworkId {
+    uint32_t value;
+} NetworkId;
+
+// Every entity that has the component must be found by it's key, and nothing else
+static void check_index(secs_world* world, secs_component_mask mask)
+{
+    size_t found = 0;
+    secs_query_iterator it = query_iter(world, CREATE_QUERY(.has = mask));
+    while (query_iter_next(&it)) {
+        NetworkId* net = field(&it, mask);
+        assert(index_find(world, mask, &net->value) == query_iter_current(&it));
+        found += 1;
+    }
+    secs_comp_list* comp = &world->lists.items[__secs_get_comp_from_bitmask(mask)];
+    assert(found == comp->count);
+    assert(comp->indexed == comp->count);
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    const secs_component_mask NET_ID = REGISTER_COMPONENT_EX(&world, NetworkId, .index_offset = offsetof(NetworkId, value), .index_size = sizeof(uint32_t));
+
+    // Bulk insert
+    secs_entity_id ids[8];
+    NetworkId nets[8];
+    for (int i = 0; i < 8; i++) {
+        ids[i] = secs_spawn(&world);
+        nets[i].value = 1000 + i;
+    }
+    insert_comp_many(&world, ids, 8, NET_ID, nets);
+    check_index(&world, NET_ID);
+
+    // Instantiate, every copy has the same key so only count matter here
+    secs_entity_id base = secs_spawn(&world);
+    insert_comp(&world, base, NET_ID, &(NetworkId) { .value = 2000 });
+    secs_prefab_id prefab = register_prefab(&world, base);
+    secs_entity_id copies[16];
+    instantiate(&world, prefab, 16, copies);
+    secs_comp_list* comp = &world.lists.items[__secs_get_comp_from_bitmask(NET_ID)];
+    assert(comp->indexed == comp->count);
+    remove_comp_many(&world, copies, 16, NET_ID);
+    check_index(&world, NET_ID);
+
+    // Merge a staging world
+    secs_world staging = {0};
+    INIT_WORLD(&staging);
+    REGISTER_COMPONENT_EX(&staging, NetworkId, .index_offset = offsetof(NetworkId, value), .index_size = sizeof(uint32_t));
+    for (int i = 0; i < 24; i++) {
+        secs_entity_id id = secs_spawn(&staging);
+        insert_comp(&staging, id, NET_ID, &(NetworkId) { .value = 3000 + i });
+    }
+    secs_world_merge(&world, &staging, NULL);
+    secs_free_world(&staging);
+    check_index(&world, NET_ID);
+
+    // Remove and compact
+    remove_comp(&world, ids[3], NET_ID);
+    secs_despawn(&world, ids[5]);
+    assert(index_find(&world, NET_ID, &(uint32_t) { 1003 }) == SECS_ENTITY_NONE);
+    secs_world_compact(&world, NULL);
+    check_index(&world, NET_ID);
+
+    printf("Entity with network id 3007: %zu\n", index_find(&world, NET_ID, &(uint32_t) { 3007 }));
+
+    secs_free_world(&world);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Transform {
+    float local, world;
+} Transform;
+
+// Every parent must be visited before it's children
+static size_t propagate(secs_world* world, secs_component_mask mask)
+{
+    size_t visited = 0;
+    secs_query_iterator it = query_iter_hierarchy(world, CREATE_QUERY(.has = mask));
+    while (query_iter_next(&it)) {
+        Transform* transform = field(&it, mask);
+        secs_entity_id parent = get_parent(world, query_iter_current(&it));
+        transform->world = transform->local;
+        if (parent != SECS_ENTITY_NONE) {
+            Transform* parent_transform = get_comp(world, parent, mask);
+            assert(parent_transform->world != 0.f);
+            transform->world += parent_transform->world;
+        }
+        visited += 1;
+    }
+    return visited;
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    const secs_component_mask TRANSFORM_ID = REGISTER_COMPONENT(&world, Transform);
+
+    secs_entity_id entities[10];
+    for (int i = 0; i < 10; i++) {
+        entities[i] = secs_spawn(&world);
+        insert_comp(&world, entities[i], TRANSFORM_ID, &(Transform) { .local = 1.f });
+    }
+    set_parent(&world, entities[9], entities[0]);
+    set_parent(&world, entities[1], entities[9]);
+    set_parent_many(&world, &entities[2], 3, entities[1]);
+    assert(propagate(&world, TRANSFORM_ID) == 10);
+    assert(((Transform*)get_comp(&world, entities[4], TRANSFORM_ID))->world == 4.f);
+
+    // Spawned entity is a root and the next hierarchy query see it
+    secs_entity_id late[5];
+    for (int i = 0; i < 5; i++) {
+        late[i] = secs_spawn(&world);
+        insert_comp(&world, late[i], TRANSFORM_ID, &(Transform) { .local = 1.f });
+        assert(get_parent(&world, late[i]) == SECS_ENTITY_NONE);
+    }
+    assert(propagate(&world, TRANSFORM_ID) == 15);
+
+    // Removing a parent make it's children root
+    secs_despawn(&world, entities[1]);
+    assert(get_parent(&world, entities[2]) == SECS_ENTITY_NONE);
+    assert(get_parent(&world, entities[9]) == entities[0]);
+
+    // Compact move entity toward lower id, the one that had no link must not inherit the previous owner link
+    secs_despawn(&world, entities[8]);
+    secs_entity_id remap[15];
+    secs_world_compact(&world, remap);
+    assert(get_parent(&world, remap[entities[9]]) == remap[entities[0]]);
+    for (int i = 0; i < 5; i++) {
+        assert(get_parent(&world, remap[late[i]]) == SECS_ENTITY_NONE);
+    }
+    assert(propagate(&world, TRANSFORM_ID) == 13);
+
+    // Removing the whole tree
+    despawn_tree(&world, remap[entities[0]]);
+    assert(!has_comp(&world, remap[entities[9]], TRANSFORM_ID));
+    assert(propagate(&world, TRANSFORM_ID) == 11);
+
+    printf("Hierarchy is consistent\n");
+
+    secs_free_world(&world);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Material {
+    float roughness;
+    int color;
+} Material;
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+// Count the entity of the value and check every one of them really has it
+static size_t count_group(secs_world* world, secs_component_mask mask, secs_shared_id handle)
+{
+    size_t count = 0;
+    const Material* value = shared_value(world, mask, handle);
+    secs_query_iterator it = query_iter(world, CREATE_QUERY(.group = mask, .group_value = handle));
+    while (query_iter_next(&it)) {
+        assert(field(&it, mask) == value);
+        count += 1;
+    }
+    return count;
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    const secs_component_mask POSITION_ID = REGISTER_COMPONENT(&world, Position);
+    const secs_component_mask MATERIAL_ID = REGISTER_COMPONENT_EX(&world, Material, .shared = true);
+
+    // 64 entity but only 4 distinct value stored
+    for (int i = 0; i < 64; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        insert_comp(&world, id, POSITION_ID, &(Position) { .x = (float)i });
+        insert_comp(&world, id, MATERIAL_ID, &(Material) { .roughness = 0.5f, .color = i % 4 });
+    }
+    assert(shared_count(&world, MATERIAL_ID) == 4);
+    Material red_material = { .roughness = 0.5f, .color = 0 };
+    Material blue_material = { .roughness = 0.5f, .color = 1 };
+    secs_shared_id red = intern_comp(&world, MATERIAL_ID, &red_material);
+    secs_shared_id blue = intern_comp(&world, MATERIAL_ID, &blue_material);
+    assert(count_group(&world, MATERIAL_ID, red) == 16);
+
+    // Changing the value of the entity that is being visited is fine
+    secs_query_iterator it = query_iter(&world, CREATE_QUERY(.has = POSITION_ID, .group = MATERIAL_ID, .group_value = red));
+    while (query_iter_next(&it)) {
+        insert_comp(&world, query_iter_current(&it), MATERIAL_ID, &blue_material);
+    }
+    assert(count_group(&world, MATERIAL_ID, red) == 0);
+    assert(count_group(&world, MATERIAL_ID, blue) == 32);
+
+    // Remove and despawn
+    remove_comp(&world, 1, MATERIAL_ID);
+    secs_despawn(&world, 5);
+    assert(count_group(&world, MATERIAL_ID, blue) == 30);
+
+    // Instantiate every copy into the same value
+    secs_prefab_id prefab = register_prefab(&world, 9);
+    secs_entity_id copies[8];
+    instantiate(&world, prefab, 8, copies);
+    assert(count_group(&world, MATERIAL_ID, blue) == 38);
+
+    // Compact rename the entity, the group follow
+    secs_world_compact(&world, NULL);
+    assert(count_group(&world, MATERIAL_ID, blue) == 38);
+    size_t total = 0;
+    for (secs_shared_id handle = 0; handle < shared_count(&world, MATERIAL_ID); handle++) {
+        total += count_group(&world, MATERIAL_ID, handle);
+    }
+    assert(total == 70);
+
+    clear_comp(&world, MATERIAL_ID);
+    assert(count_group(&world, MATERIAL_ID, blue) == 0);
+
+    printf("Distinct material: %zu\n", shared_count(&world, MATERIAL_ID));
+
+    secs_free_world(&world);
+
+    return 0;
+}
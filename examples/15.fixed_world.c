@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stddef.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Team {
+    int id;
+} Team;
+
+typedef struct Hit {
+    secs_entity_id target;
+    float damage[14];
+} Hit;
+
+// Everything the world ever use live inside this buffer, nothing is allocated from the system
+static char buffer[64 * 1024];
+
+int main()
+{
+    secs_world world = {0};
+    bool ok = secs_init_world_fixed(&world, buffer, sizeof(buffer), 512);
+    assert(ok);
+
+    const secs_component_mask POSITION_ID = REGISTER_COMPONENT_EX(&world, Position, .capacity = 256);
+    const secs_component_mask TEAM_ID = REGISTER_COMPONENT_EX(&world, Team, .shared = true);
+    assert(POSITION_ID && TEAM_ID);
+
+    // Full pool is reported instead of growing
+    for (int i = 0; i < 512; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        assert(id == (secs_entity_id)i);
+        assert(insert_comp(&world, id, POSITION_ID, &(Position) { .x = (float)i }) == (i < 256));
+    }
+    assert(secs_spawn(&world) == SECS_ENTITY_NONE);
+
+    // Sorting every frame borrow scratch memory from the buffer and give every byte of it back
+    secs_sort_desc by_x = { .offset = offsetof(Position, x), .key = SECS_SORT_F32 };
+    for (int frame = 0; frame < 1000; frame++) {
+        ((Position*)get_comp(&world, frame % 256, POSITION_ID))->x = (float)(frame * 7 % 256);
+        assert(sort_comp(&world, POSITION_ID, by_x));
+    }
+
+    // Every distinct shared value take some of the buffer, until there is none left
+    int stored = 0;
+    for (int i = 0; i < 512; i++) {
+        if (!insert_comp(&world, i, TEAM_ID, &(Team) { .id = i })) break;
+        stored += 1;
+    }
+    assert(stored > 0 && stored < 512);
+    assert(shared_count(&world, TEAM_ID) == (size_t)stored);
+    // An already interned value still fit
+    assert(insert_comp(&world, stored, TEAM_ID, &(Team) { .id = 0 }));
+
+    // Everything else that need memory report it too
+    assert(REGISTER_EVENT(&world, Hit, 256) == SECS_EVENT_NONE);
+    assert(!set_parent(&world, 1, 0));
+    assert(get_parent(&world, 1) == SECS_ENTITY_NONE);
+    assert(!sort_comp(&world, POSITION_ID, by_x));
+
+    // Remove free the slot for someone else
+    remove_comp(&world, 0, POSITION_ID);
+    assert(insert_comp(&world, 300, POSITION_ID, &(Position) { .x = 300.f }));
+    assert(!insert_comp(&world, 301, POSITION_ID, &(Position) { .x = 301.f }));
+
+    // Merging staging world that doesn't fit leave the fixed world untouched
+    secs_world staging = {0};
+    INIT_WORLD(&staging);
+    REGISTER_COMPONENT_EX(&staging, Position);
+    REGISTER_COMPONENT_EX(&staging, Team, .shared = true);
+    secs_entity_id staged = secs_spawn(&staging);
+    insert_comp(&staging, staged, POSITION_ID, &(Position) { .x = -1.f });
+    insert_comp(&staging, staged, TEAM_ID, &(Team) { .id = 1 });
+    size_t used = secs_world_memory_usage(&world);
+    assert(!secs_world_merge(&world, &staging, NULL));
+    assert(secs_world_id_range(&world) == 512);
+    assert(shared_count(&world, TEAM_ID) == (size_t)stored);
+    assert(secs_world_memory_usage(&world) == used);
+
+    // Once there is room it's merged
+    secs_despawn(&world, 10);
+    secs_despawn(&world, 11);
+    assert(secs_world_merge(&world, &staging, NULL));
+    assert(has_comp(&world, 10, POSITION_ID) && shared_count(&world, TEAM_ID) == (size_t)stored);
+    secs_free_world(&staging);
+
+    // Compact keep everything inside the buffer
+    secs_world_compact(&world, NULL);
+    size_t count = 0;
+    secs_query_iterator it = query_iter(&world, CREATE_QUERY(.has = POSITION_ID));
+    while (query_iter_next(&it)) count += 1;
+    assert(count == 255);
+
+    printf("Stored %d team before the buffer is full\n", stored);
+
+    secs_free_world(&world);
+
+    return 0;
+}
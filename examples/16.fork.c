@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Health {
+    int value;
+} Health;
+
+// Count what is really taken from the system, the world memory usage count the shared array in both world
+static void* counted_alloc(void* ctx, size_t size)
+{
+    *(size_t*)ctx += size;
+    return malloc(size);
+}
+
+static void* counted_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    *(size_t*)ctx += new_size - old_size;
+    return realloc(ptr, new_size);
+}
+
+static void counted_free(void* ctx, void* ptr, size_t size)
+{
+    *(size_t*)ctx -= size;
+    free(ptr);
+}
+
+static size_t count_query(secs_world* world, secs_query query)
+{
+    size_t count = 0;
+    secs_query_iterator it = query_iter(world, query);
+    while (query_iter_next(&it)) count += 1;
+    return count;
+}
+
+int main()
+{
+    size_t taken = 0;
+    secs_world world = {0};
+    init_world_with_allocator(&world, ((secs_allocator) {
+        .alloc = counted_alloc,
+        .realloc = counted_realloc,
+        .free = counted_free,
+        .ctx = &taken,
+    }));
+
+    const secs_component_mask POSITION_ID = REGISTER_COMPONENT_EX(&world, Position, .storage = SECS_STORAGE_CHUNKED);
+    const secs_component_mask HEALTH_ID = REGISTER_COMPONENT(&world, Health);
+
+    for (int i = 0; i < 10000; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        insert_comp(&world, id, POSITION_ID, &(Position) { .x = (float)i });
+        insert_comp(&world, id, HEALTH_ID, &(Health) { .value = 100 });
+    }
+    set_parent(&world, 1, 0);
+    size_t parent_memory = taken;
+
+    // The fork point into the parent array, only the list of pool is copied
+    secs_world what_if = {0};
+    secs_world_fork(&world, &what_if);
+    size_t fork_memory = taken - parent_memory;
+    assert(fork_memory * 50 < parent_memory);
+    assert(secs_world_memory_usage(&what_if) == secs_world_memory_usage(&world));
+
+    // Reading copy nothing
+    float sum = 0.f;
+    secs_query_iterator it = query_iter(&what_if, CREATE_QUERY(.has = POSITION_ID));
+    while (query_iter_next(&it)) {
+        sum += ((const Position*)peek_field(&it, POSITION_ID))->x;
+    }
+    assert(sum > 0.f);
+    assert(get_parent(&what_if, 1) == 0);
+    assert(taken - parent_memory == fork_memory);
+
+    // Writing only change the fork
+    ((Health*)get_comp(&what_if, 5, HEALTH_ID))->value = 0;
+    ((Position*)get_comp(&what_if, 5, POSITION_ID))->x = -1.f;
+    assert(((const Health*)peek_comp(&world, 5, HEALTH_ID))->value == 100);
+    assert(((const Position*)peek_comp(&world, 5, POSITION_ID))->x == 5.f);
+
+    // Remove, bulk and compact
+    remove_comp(&what_if, 6, HEALTH_ID);
+    secs_entity_id victims[4] = { 10, 11, 12, 13 };
+    despawn_many(&what_if, victims, 4);
+    Health healths[4] = { { 1 }, { 2 }, { 3 }, { 4 } };
+    secs_entity_id healed[4] = { 20, 21, 22, 23 };
+    insert_comp_many(&what_if, healed, 4, HEALTH_ID, healths);
+    secs_world_compact(&what_if, NULL);
+    assert(count_query(&what_if, CREATE_QUERY(.has = HEALTH_ID)) == 9995);
+    assert(count_query(&world, CREATE_QUERY(.has = HEALTH_ID)) == 10000);
+    assert(has_comp(&world, 6, HEALTH_ID) && has_comp(&world, 10, POSITION_ID));
+    assert(((const Health*)peek_comp(&world, 20, HEALTH_ID))->value == 100);
+
+    // The parent can still be written and the fork doesn't see it
+    secs_despawn(&world, 0);
+    assert(get_parent(&what_if, 1) == 0);
+
+    secs_free_world(&what_if);
+    for (int i = 1; i < 10000; i++) {
+        assert(((const Position*)peek_comp(&world, i, POSITION_ID))->x == (float)i);
+    }
+
+    printf("Parent world memory: %zu bytes, unwritten fork: %zu bytes\n", parent_memory, fork_memory);
+
+    secs_free_world(&world);
+    // The last world that use the shared array free it
+    assert(taken == 0);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+typedef struct Health {
+    int value;
+} Health;
+
+// The order is the order of registration, the mask is known at compile time
+DECLARE_COMPONENT(Position, 0)
+DECLARE_COMPONENT(Velocity, 1)
+DECLARE_COMPONENT(Health, 2)
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    secs_register_Position(&world);
+    // Declared component can still be registered with extra parameter as long as the order match
+    secs_component_mask velocity = REGISTER_COMPONENT_EX(&world, Velocity, .storage = SECS_STORAGE_CHUNKED);
+    secs_component_mask health = REGISTER_COMPONENT_EX(&world, Health, .double_buffered = true);
+    assert(velocity == COMP_MASK(Velocity) && health == COMP_MASK(Health));
+
+    for (int i = 0; i < 1000; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        secs_insert_Position(&world, id, (Position) { .x = (float)i });
+        secs_insert_Velocity(&world, id, (Velocity) { .x = 1.f });
+        if (i % 2 == 0) secs_insert_Health(&world, id, (Health) { .value = i });
+    }
+
+    // New double buffered component start the same on both side
+    const Health* previous = get_comp_prev(&world, 10, COMP_MASK(Health));
+    assert(previous->value == 10);
+    secs_insert_Health(&world, 10, (Health) { .value = 11 });
+    assert(previous->value == 10 && secs_peek_Health(&world, 10)->value == 11);
+
+    secs_query_iterator it = query_iter(&world, CREATE_QUERY(.has = COMP_MASK(Position) | COMP_MASK(Velocity)));
+    while (query_iter_next(&it)) {
+        secs_field_Position(&it)->x += secs_field_Velocity(&it)->x;
+    }
+    assert(secs_peek_Position(&world, 999)->x == 1000.f);
+    assert(secs_get_Velocity(&world, 999) == get_comp(&world, 999, COMP_MASK(Velocity)));
+
+    secs_remove_Health(&world, 2);
+    assert(!secs_has_Health(&world, 2) && secs_get_Health(&world, 2) == NULL);
+    secs_despawn(&world, 4);
+    assert(secs_peek_Health(&world, 6)->value == 6);
+
+    // Writing through the accessor into a fork copy the pool first
+    secs_world fork = {0};
+    secs_world_fork(&world, &fork);
+    secs_get_Position(&fork, 7)->x = -1.f;
+    secs_get_Velocity(&fork, 7)->x = -1.f;
+    assert(secs_peek_Position(&world, 7)->x == 8.f);
+    assert(secs_peek_Velocity(&world, 7)->x == 1.f);
+    assert(secs_peek_Velocity(&fork, 7)->x == -1.f);
+    secs_free_world(&fork);
+
+    printf("Position of 999: %f\n", secs_peek_Position(&world, 999)->x);
+
+    secs_free_world(&world);
+
+    return 0;
+}
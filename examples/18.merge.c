@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Faction {
+    int id;
+} Faction;
+
+static size_t count_query(secs_world* world, secs_query query)
+{
+    size_t count = 0;
+    secs_query_iterator it = query_iter(world, query);
+    while (query_iter_next(&it)) count += 1;
+    return count;
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+    const secs_component_mask POSITION_ID = REGISTER_COMPONENT(&world, Position);
+    const secs_component_mask FACTION_ID = REGISTER_COMPONENT_EX(&world, Faction, .shared = true);
+
+    for (int i = 0; i < 100; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        insert_comp(&world, id, POSITION_ID, &(Position) { .x = (float)i });
+        insert_comp(&world, id, FACTION_ID, &(Faction) { .id = i % 2 });
+    }
+    // Leave some hole, the merged entity take them first
+    for (secs_entity_id id = 10; id < 20; id++) {
+        secs_despawn(&world, id);
+    }
+
+    // Level chunk loaded on the side, it must register the same component in the same order
+    secs_world staging = {0};
+    INIT_WORLD(&staging);
+    REGISTER_COMPONENT_EX(&staging, Position, .storage = SECS_STORAGE_CHUNKED);
+    REGISTER_COMPONENT_EX(&staging, Faction, .shared = true);
+    for (int i = 0; i < 50; i++) {
+        secs_entity_id id = secs_spawn(&staging);
+        insert_comp(&staging, id, POSITION_ID, &(Position) { .x = 1000.f + i });
+        insert_comp(&staging, id, FACTION_ID, &(Faction) { .id = i % 3 });
+    }
+    set_parent(&staging, 1, 0);
+    set_parent(&staging, 2, 0);
+    secs_sleep(&staging, 3);
+    secs_entity_id removed[5] = { 40, 41, 42, 43, 44 };
+    despawn_many(&staging, removed, 5);
+
+    secs_entity_id remap[50];
+    bool merged = secs_world_merge(&world, &staging, remap);
+    assert(merged);
+    assert(remap[0] == 10 && remap[40] == SECS_ENTITY_NONE);
+    assert(((const Position*)peek_comp(&world, remap[7], POSITION_ID))->x == 1007.f);
+    assert(get_parent(&world, remap[2]) == remap[0]);
+    assert(secs_is_dormant(&world, remap[3]));
+    // Only the one value that wasn't there is interned
+    assert(shared_count(&world, FACTION_ID) == 3);
+    assert(count_query(&world, CREATE_QUERY(.has = POSITION_ID)) == 90 + 45 - 1);
+    assert(count_query(&world, CREATE_QUERY(.group = FACTION_ID, .group_value = 2)) == 14);
+    // The staging world is left as it is
+    assert(count_query(&staging, CREATE_QUERY(.has = POSITION_ID)) == 44);
+    secs_free_world(&staging);
+
+    // Merged entity is like any other one
+    remove_comp(&world, remap[5], FACTION_ID);
+    secs_entity_id compacted[150];
+    secs_world_compact(&world, compacted);
+    assert(secs_world_id_range(&world) == 135);
+    assert(get_parent(&world, compacted[remap[1]]) == compacted[remap[0]]);
+    assert(((const Position*)peek_comp(&world, compacted[remap[49]], POSITION_ID))->x == 1049.f);
+    assert(count_query(&world, CREATE_QUERY(.group = FACTION_ID, .group_value = 2)) == 13);
+
+    printf("World has %zu entity after merging\n", secs_world_id_range(&world));
+
+    secs_free_world(&world);
+
+    return 0;
+}
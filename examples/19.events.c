@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Damage {
+    secs_entity_id target;
+    int amount;
+} Damage;
+
+// The run stop where the ring buffer wrap around so keep reading until nothing is left
+static int read_total(secs_world* world, secs_event_reader* reader)
+{
+    int total = 0;
+    const void* events = NULL;
+    size_t count = 0;
+    while ((count = read_events(world, reader, &events)) > 0) {
+        const Damage* damages = events;
+        for (size_t i = 0; i < count; i++) {
+            total += damages[i].amount;
+        }
+    }
+    return total;
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    // The whole ring buffer is allocated here, sending never allocate
+    const secs_event_id DAMAGE_ID = REGISTER_EVENT(&world, Damage, 8);
+    secs_event_reader health_system = event_reader_init(&world, DAMAGE_ID);
+    secs_event_reader sound_system = event_reader_init(&world, DAMAGE_ID);
+
+    // Frame 1
+    for (int i = 1; i <= 3; i++) {
+        send_event(&world, DAMAGE_ID, &(Damage) { .target = 0, .amount = i });
+    }
+    assert(read_total(&world, &health_system) == 6);
+    assert(read_total(&world, &health_system) == 0);
+    update_events(&world);
+
+    // Frame 2, the sound system run before the event is sent but still see the one from frame 1
+    assert(read_total(&world, &sound_system) == 6);
+    Damage* damage = emit_event(&world, DAMAGE_ID);
+    damage->target = 1;
+    damage->amount = 10;
+    assert(read_total(&world, &health_system) == 10);
+    update_events(&world);
+
+    // Frame 3, event of frame 1 is gone, the one of frame 2 is still there for the late reader
+    secs_event_reader late = event_reader_init(&world, DAMAGE_ID);
+    assert(read_total(&world, &late) == 10);
+    assert(read_total(&world, &sound_system) == 10);
+
+    // Full channel drop the oldest event, the reader that fall behind skip them
+    for (int i = 0; i < 12; i++) {
+        send_event(&world, DAMAGE_ID, &(Damage) { .target = 2, .amount = 100 });
+    }
+    assert(read_total(&world, &sound_system) == 800);
+    update_events(&world);
+    update_events(&world);
+    assert(read_total(&world, &health_system) == 0);
+
+    // Reader kept across reset doesn't read garbage
+    secs_reset_world(&world);
+    assert(read_total(&world, &health_system) == 0);
+
+    printf("Every damage is read once per system\n");
+
+    secs_free_world(&world);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <assert.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Collider {
+    float radius;
+} Collider;
+
+typedef struct Broadphase {
+    size_t added;
+    size_t removed;
+    secs_entity_id last;
+} Broadphase;
+
+static void on_collider_added(secs_world* world, const secs_entity_id* ids, size_t count, void* user_data)
+{
+    (void)world;
+    Broadphase* broadphase = user_data;
+    broadphase->added += count;
+    broadphase->last = ids[count - 1];
+}
+
+static void on_collider_removed(secs_world* world, const secs_entity_id* ids, size_t count, void* user_data)
+{
+    (void)world;
+    (void)ids;
+    Broadphase* broadphase = user_data;
+    broadphase->removed += count;
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    const secs_component_mask COLLIDER_ID = REGISTER_COMPONENT(&world, Collider);
+    Broadphase broadphase = {0};
+    register_observer(&world, COLLIDER_ID, SECS_ON_ADD, on_collider_added, &broadphase);
+    register_observer(&world, COLLIDER_ID, SECS_ON_REMOVE, on_collider_removed, &broadphase);
+
+    // Nothing is called until the dispatch, then the whole batch arrive at once
+    secs_entity_id ids[32];
+    Collider colliders[32];
+    for (int i = 0; i < 32; i++) {
+        ids[i] = secs_spawn(&world);
+        colliders[i].radius = 1.f;
+    }
+    insert_comp_many(&world, ids, 16, COLLIDER_ID, colliders);
+    for (int i = 16; i < 32; i++) {
+        insert_comp(&world, ids[i], COLLIDER_ID, &colliders[i]);
+    }
+    assert(broadphase.added == 0);
+    dispatch_observers(&world);
+    assert(broadphase.added == 32 && broadphase.last == ids[31]);
+
+    // Overwriting is not adding
+    insert_comp(&world, ids[0], COLLIDER_ID, &(Collider) { .radius = 2.f });
+    dispatch_observers(&world);
+    assert(broadphase.added == 32);
+
+    // Remove, bulk remove, despawn and clear are all reported
+    remove_comp(&world, ids[0], COLLIDER_ID);
+    remove_comp_many(&world, &ids[1], 3, COLLIDER_ID);
+    despawn_many(&world, &ids[4], 4);
+    dispatch_observers(&world);
+    assert(broadphase.removed == 8);
+
+    // Compact rename the entity that is still waiting to be dispatched, the despawned one is dropped
+    secs_despawn(&world, ids[8]);
+    secs_entity_id late = ids[31];
+    remove_comp(&world, late, COLLIDER_ID);
+    insert_comp(&world, late, COLLIDER_ID, &(Collider) { .radius = 3.f });
+    secs_entity_id remap[32];
+    secs_world_compact(&world, remap);
+    dispatch_observers(&world);
+    assert(remap[late] != late);
+    assert(broadphase.added == 33 && broadphase.last == remap[late]);
+    assert(broadphase.removed == 9);
+
+    clear_comp(&world, COLLIDER_ID);
+    dispatch_observers(&world);
+    assert(broadphase.removed == 9 + 23);
+
+    printf("Broadphase saw %zu add and %zu remove\n", broadphase.added, broadphase.removed);
+
+    secs_free_world(&world);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stddef.h>
+#define RSECS_STRIP_PREFIX
+#define RSECS_IMPLEMENTATION
+#include "../rsecs.h"
+
+
+typedef struct Sprite {
+    int texture;
+    float depth;
+} Sprite;
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+// Walk the pool order, every depth must be at least the previous one
+static size_t check_order(secs_world* world, secs_component_mask sprite, secs_component_mask position)
+{
+    size_t visited = 0;
+    float last = -1000.f;
+    secs_query_iterator it = query_iter_sorted(world, CREATE_QUERY(.has = sprite), sprite);
+    while (query_iter_next(&it)) {
+        const Sprite* current = peek_field(&it, sprite);
+        assert(current->depth >= last);
+        const Position* at = peek_field(&it, position);
+        if (at) assert(at->y == current->depth);
+        last = current->depth;
+        visited += 1;
+    }
+    // The co-owned pool is walked in the same order
+    last = -1000.f;
+    it = query_iter_sorted(world, CREATE_QUERY(.has = sprite | position), position);
+    while (query_iter_next(&it)) {
+        const Position* at = peek_field(&it, position);
+        assert(at->y >= last);
+        last = at->y;
+    }
+    return visited;
+}
+
+int main()
+{
+    secs_world world = {0};
+    INIT_WORLD(&world);
+
+    const secs_component_mask SPRITE_ID = REGISTER_COMPONENT(&world, Sprite);
+    const secs_component_mask POSITION_ID = REGISTER_COMPONENT(&world, Position);
+
+    for (int i = 0; i < 1000; i++) {
+        secs_entity_id id = secs_spawn(&world);
+        float depth = (float)((i * 7919) % 1000) - 500.f;
+        insert_comp(&world, id, SPRITE_ID, &(Sprite) { .texture = i % 4, .depth = depth });
+        insert_comp(&world, id, POSITION_ID, &(Position) { .x = (float)i, .y = depth });
+    }
+
+    // Position follow the same order so drawing walk both pool forward
+    secs_sort_desc by_depth = { .offset = offsetof(Sprite, depth), .key = SECS_SORT_F32, .co_owned = POSITION_ID };
+    sort_comp(&world, SPRITE_ID, by_depth);
+    assert(check_order(&world, SPRITE_ID, POSITION_ID) == 1000);
+
+    // Small change, insertion sort is enough
+    ((Sprite*)get_comp(&world, 10, SPRITE_ID))->depth = 499.5f;
+    ((Position*)get_comp(&world, 10, POSITION_ID))->y = 499.5f;
+    by_depth.nearly_sorted = true;
+    sort_comp(&world, SPRITE_ID, by_depth);
+    assert(check_order(&world, SPRITE_ID, POSITION_ID) == 1000);
+
+    // Remove and bulk insert break the order until the next sort
+    secs_entity_id victims[100];
+    for (int i = 0; i < 100; i++) victims[i] = i * 3;
+    remove_comp_many(&world, victims, 100, SPRITE_ID);
+    Sprite back[100];
+    for (int i = 0; i < 100; i++) back[i] = (Sprite) { .depth = ((const Position*)peek_comp(&world, victims[i], POSITION_ID))->y };
+    insert_comp_many(&world, victims, 100, SPRITE_ID, back);
+    secs_despawn(&world, 1);
+    by_depth.nearly_sorted = false;
+    sort_comp(&world, SPRITE_ID, by_depth);
+    assert(check_order(&world, SPRITE_ID, POSITION_ID) == 999);
+
+    // Dormant entity is not visited and not sorted
+    secs_sleep(&world, 2);
+    sort_comp(&world, SPRITE_ID, by_depth);
+    assert(check_order(&world, SPRITE_ID, POSITION_ID) == 998);
+
+    // Compact move entity around, sorting again after it is still correct
+    secs_world_compact(&world, NULL);
+    sort_comp(&world, SPRITE_ID, by_depth);
+    assert(check_order(&world, SPRITE_ID, POSITION_ID) == 998);
+
+    printf("Sprite is drawn back to front\n");
+
+    secs_free_world(&world);
+
+    return 0;
+}
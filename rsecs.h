@@ -1,10 +1,12 @@
 /*
-rsecs.h - v0.4 UnknownRori <unknownrori@proton.me>
+rsecs.h - v0.29 UnknownRori <unknownrori@proton.me>
 
 Unprofressional implementation of ECS for C99 with stb style header file
 I suggest on using <https://github.com/SanderMertens/flecs> instead of this for production ready stuff.
 The current implementation is by using Sparse Set and Bitmask Archetype, and it can be somewhat cache friendly.
 But all of the operation should be O(1) [Creating, Updating] for Deleting currently it will loop all of it to deallocate them
+Every component pool also keep a bitset of it's entity so query can skip 64 entity at a time, or 4096 if the area is empty
+Dormant entity is kept at the back of every pool and out of the bitset so query skip them for free
 
 Table of Contents : 
 - Quick Example
@@ -78,33 +80,123 @@ int main()
  - secs_component_mask      - Lifeblood of the mask system, it just mapped to size_t
  - secs_query               - Query parameter for fetching entity with certain component combination
  - secs_query_iterator      - Ready to use iterator
+ - secs_prefab_id           - Id of the entity template registered by [`secs_register_prefab`]
+ - secs_shared_id           - Handle of the distinct value of shared component
+ - secs_allocator           - Allocator interface (alloc/realloc/free + context) used by every internal array of the world
+ - secs_arena               - Linear arena allocator, throw away everything at once with [`secs_arena_reset`]
+ - secs_pool                - Size-class pool allocator for long running world
+ - secs_vm                  - Virtual memory allocator, reserve huge range up front and commit page as the array grow
+ - secs_component_desc      - Component registration parameter, size, storage policy, if it's shared, it's index key and if it's double buffered
+ - secs_storage             - Storage policy of the component pool, contiguous or chunked (pointer stay valid when the pool grow)
+ - secs_sort_desc           - Sorting parameter, where the key is, it's type and which pool follow the order
+ - secs_sort_key            - Type of the sort key, integer or float of 32 or 64 bit
+ - secs_event_id            - Id of the event channel registered by [`secs_register_event`]
+ - secs_event_reader        - Cursor of a single reader of event channel
+ - secs_observer_id         - Id of the observer registered by [`secs_register_observer`]
+ - secs_observer_event      - What the observer react to, component added or removed
+ - secs_observer_fn         - Callback that receive the batch of entity
 
 ### Function
  - void secs_init_world(secs_world*); - Initialize [`secs_world`] struct
  - void secs_free_world(secs_world*); - Free memory allocated inside [`secs_world`] struct
  - void secs_reset_world(secs_world* world) - Set all the count to 0 effectively mark everything as unused except the registered component
+ - void secs_init_world_with_allocator(secs_world*, secs_allocator); - Initialize [`secs_world`] struct that allocate through custom allocator
+ - bool secs_init_world_fixed(secs_world*, void*, size_t, size_t); - Initialize [`secs_world`] over caller buffer with hard limit of entity, nothing grow after registration
+ - size_t secs_world_memory_usage(secs_world*); - Amount of bytes currently allocated by the world
+ - size_t secs_world_id_range(secs_world*); - Every entity id is lower than this
+ - void secs_world_compact(secs_world*, secs_entity_id*); - Sort component by entity id, give back unused memory and optionally renumber entity
+ - bool secs_world_merge(secs_world*, secs_world*, secs_entity_id*); - Move every entity of staging world into another world pool by pool
+ - void secs_world_fork(secs_world*, secs_world*); - Create a child world that share every array of the parent until it's written, discard it with [`secs_free_world`]
 
- - secs_entity_id secs_spawn(secs_world*); - Creating new entity
+ - secs_allocator secs_default_allocator(void); - Allocator that use `RSTB_DA_REALLOC` and `RSTB_DA_FREE`
+ - void secs_arena_init(secs_arena*, void*, size_t); - Initialize arena over a buffer, pass NULL to let the arena allocate it
+ - void secs_arena_reset(secs_arena*); - Mark the whole arena as unused
+ - void secs_arena_free(secs_arena*); - Free the arena buffer if it's owned by the arena
+ - secs_allocator secs_arena_allocator(secs_arena*); - Get allocator interface of the arena
+ - void secs_pool_init(secs_pool*); - Initialize size-class pool allocator
+ - void secs_pool_free(secs_pool*); - Give back all the slab to the system
+ - secs_allocator secs_pool_allocator(secs_pool*); - Get allocator interface of the pool
+ - void secs_vm_init(secs_vm*, size_t); - Initialize virtual memory allocator with how many bytes reserved per big array
+ - secs_allocator secs_vm_allocator(secs_vm*); - Get allocator interface of the virtual memory allocator
+
+ - secs_entity_id secs_spawn(secs_world*); - Creating new entity, [`SECS_ENTITY_NONE`] when fixed world is full
  - void secs_despawn(secs_world*, secs_entity_id); - Despawning entity
- - void secs_insert_comp(secs_world*, secs_entity_id, secs_component_mask, void*); - Attach a component into entity and overwrite if it exist
+ - void secs_spawn_begin(secs_world*, size_t); - Reserve id for [`secs_spawn_concurrent`], dead id is recycled first
+ - secs_entity_id secs_spawn_concurrent(secs_world*); - Take one reserved id, safe to call from many thread
+ - size_t secs_spawn_concurrent_many(secs_world*, size_t, secs_entity_id*); - Take a block of reserved id at once, safe to call from many thread
+ - void secs_spawn_end(secs_world*); - Close the spawn window and give back the id nobody took
+ - void secs_despawn_many(secs_world*, const secs_entity_id*, size_t); - Despawning many entity at once
+ - size_t secs_despawn_query(secs_world*, secs_query); - Despawning every entity that match the query
+ - secs_prefab_id secs_register_prefab(secs_world*, secs_entity_id); - Snapshot the entity component as template, [`SECS_PREFAB_NONE`] when fixed world is full
+ - bool secs_instantiate(secs_world*, secs_prefab_id, size_t, secs_entity_id*); - Spawn many copy of the prefab, false when fixed world is full
+ - bool secs_insert_comp(secs_world*, secs_entity_id, secs_component_mask, void*); - Attach a component into entity and overwrite if it exist, false when fixed world is full
+ - void* secs_emplace_comp(secs_world*, secs_entity_id, secs_component_mask); - Attach a component and return it's slot to be initialized in place
+ - void* secs_emplace_comp_many(secs_world*, const secs_entity_id*, size_t, secs_component_mask); - Attach a component into many entity and return contiguous slot
  - bool secs_has_comp(secs_world*, secs_entity_id, secs_component_mask); - Check if entity has component
  - bool secs_has_not_comp(secs_world*, secs_entity_id, secs_component_mask); - Check if entity doesn't component
  - void secs_remove_comp(secs_world*, secs_entity_id, secs_component_mask); - Remove component from entity
+ - bool secs_insert_comp_many(secs_world*, const secs_entity_id*, size_t, secs_component_mask, const void*); - Attach array of component into many entity, false when fixed world is full
+ - void secs_remove_comp_many(secs_world*, const secs_entity_id*, size_t, secs_component_mask); - Remove component from many entity
+ - void secs_clear_comp(secs_world*, secs_component_mask); - Remove the component from every entity
 
  - void* secs_get_comp(secs_world*, secs_entity_id, secs_component_mask); - Get the component from entity, it will return NULL if it doesnt have any
+ - secs_shared_id secs_intern_comp(secs_world*, secs_component_mask, const void*); - Get the handle of the shared value, storing it if it's new
+ - size_t secs_shared_count(secs_world*, secs_component_mask); - How many distinct value the shared component has
+ - const void* secs_shared_value(secs_world*, secs_component_mask, secs_shared_id); - Get the shared value from it's handle
+ - secs_entity_id secs_index_find(secs_world*, secs_component_mask, const void*); - Find the entity by the key of indexed component
+ - const void* secs_peek_comp(secs_world*, secs_entity_id, secs_component_mask); - Get the component for reading only, it never copy the shared chunk
+ - const void* secs_get_comp_prev(secs_world*, secs_entity_id, secs_component_mask); - Get the previous frame side of double buffered component
+ - void secs_swap_buffers(secs_world*); - Flip every double buffered component, call it once at the end of the frame
+
+ - bool secs_set_parent(secs_world*, secs_entity_id, secs_entity_id); - Attach entity under the parent, [`SECS_ENTITY_NONE`] detach it
+ - bool secs_set_parent_many(secs_world*, const secs_entity_id*, size_t, secs_entity_id); - Attach many entity under the same parent, false when fixed world is full
+ - secs_entity_id secs_get_parent(secs_world*, secs_entity_id); - Get the parent of the entity or [`SECS_ENTITY_NONE`]
+ - void secs_despawn_tree(secs_world*, secs_entity_id); - Despawn the entity along with all of it's descendant
+
+ - void secs_sleep(secs_world*, secs_entity_id); - Make the entity dormant, it's hidden from every query
+ - void secs_wake(secs_world*, secs_entity_id); - Make dormant entity visible again
+ - bool secs_is_dormant(secs_world*, secs_entity_id); - Check if the entity is dormant
+ - secs_component_mask secs_register_component_desc(secs_world*, secs_component_desc); - Register component with storage policy
+
  - secs_query_iterator secs_query_iter(secs_world*, secs_query); - Create a iterator from query
+ - secs_query_iterator secs_query_iter_hierarchy(secs_world*, secs_query); - Create a iterator that visit parent before it's children
+ - secs_query_iterator secs_query_iter_sorted(secs_world*, secs_query, secs_component_mask); - Create a iterator that follow the order of the component pool
+ - bool secs_sort_comp(secs_world*, secs_component_mask, secs_sort_desc); - Sort the component pool in place by a key inside the component, false when fixed world is full
+
+ - secs_event_id secs_register_event(secs_world*, size_t, size_t); - Register event channel with the event size and how many event it can hold, [`SECS_EVENT_NONE`] when fixed world is full
+ - void secs_send_event(secs_world*, secs_event_id, const void*); - Copy the event into the channel
+ - void* secs_emit_event(secs_world*, secs_event_id); - Reserve the next event and return it to be written in place
+ - secs_event_reader secs_event_reader_init(secs_world*, secs_event_id); - Create a reader that start from the oldest event
+ - size_t secs_read_events(secs_world*, secs_event_reader*, const void**); - Get the next contiguous run of unread event
+ - void secs_update_events(secs_world*); - Drop every event that is older than the previous update, call it once per frame
+
+ - secs_observer_id secs_register_observer(secs_world*, secs_component_mask, secs_observer_event, secs_observer_fn, void*); - Buffer the entity when the component is added or removed, [`SECS_OBSERVER_NONE`] when fixed world is full
+ - void secs_dispatch_observers(secs_world*); - Call every observer with it's buffered entity in one batch
  - bool secs_query_iter_next(secs_query_iterator*); - Continue the iteration
- - void* secs_field(secs_query_iterator*, secs_component_mask); - Get the component from the iteration
+ - bool secs_query_iter_next_budget(secs_query_iterator*, size_t, double); - Continue the iteration until the entity count or time budget run out
+ - void* secs_field(secs_query_iterator*, secs_component_mask); - Get the component from the iteration, NULL if the entity doesn't have it
+ - const void* secs_peek_field(secs_query_iterator*, secs_component_mask); - Get the component from the iteration for reading only
+ - const void* secs_field_prev(secs_query_iterator*, secs_component_mask); - Get the previous frame side of double buffered component from the iteration
 
 ### Macro
  - SECS_INIT_WORLD(WORLD)                   - Initialize [`secs_world`] struct.
  - SECS_REGISTER_COMPONENT(WORLD, TYPES)    - Register component into [`secs_world`] struct and also initialize [`secs_world`] memory chunk
+ - SECS_REGISTER_COMPONENT_EX(WORLD, TYPES, ...) - Same as above but with extra [`secs_component_desc`] field like `.storage = SECS_STORAGE_CHUNKED`
+ - SECS_REGISTER_EVENT(WORLD, TYPES, CAPACITY) - Register event channel of that type
  - CREATE_QUERY(QUERY)                      - Generate query for iteration
+ - SECS_DECLARE_COMPONENT(TYPE, ORDER)      - Generate typed `secs_register_TYPE`, `secs_insert_TYPE`, `secs_get_TYPE`, `secs_field_TYPE` and friends
+ - SECS_COMP_MASK(TYPE)                     - Compile time mask of component declared by [`SECS_DECLARE_COMPONENT`]
+ - secs_query_iter_done(IT)                 - Check if the iterator already visit every entity
 
 ## Flag
 
  - RSECS_IMPLEMENTATION     - Include the implementation detail
  - RSECS_STRIP_PREFIX       - Remove all the `secs_` prefixes by using macro
+ - RSECS_NO_VIRTUAL_MEMORY  - Remove [`secs_vm`] for platform without mmap or VirtualAlloc
+ - RSECS_CLOCK              - Clock used by [`secs_query_iter_next_budget`], it must return seconds as double,
+                              the default is monotonic clock, strict C99 that include a system header first fall back to `clock`,
+                              freestanding build has no default and time budget assert until one is provided
+ - RSECS_ATOMIC_ADD         - Atomic fetch-add of `size_t` used by [`secs_spawn_concurrent`], default to compiler builtin
 
 ## Built-in Dependencies
 
@@ -117,6 +209,31 @@ int main()
  - 0.2      - Small Optimization, fix some buggy unnecesarily allocation, improve query API, Improve documentation
  - 0.3      - Added reset world function
  - 0.4      - Fix some data size calculation and implement remove in component pool properly
+ - 0.5      - Added per-world allocator interface with arena and pool allocator, fix component pool never freed
+ - 0.6      - Added virtual memory reserve/commit allocator so huge array grow without copying
+ - 0.7      - Added chunked storage policy so component pointer stay valid when the pool grow
+ - 0.8      - Despawned id is recycled lowest first by using hierarchical bitset, and the world shrink when the last entity despawned
+ - 0.9      - Added world compaction, component pool remember it's entity so removing component is O(1)
+ - 0.10     - Every component pool keep two level bitset of it's entity, query intersect them 64 entity at a time
+ - 0.11     - Added emplace API that return the component slot instead of copying from temporary
+ - 0.12     - Added bulk insert, bulk remove and clear of a single component
+ - 0.13     - Added bulk despawn and despawn every entity that match a query
+ - 0.14     - Added prefab, instantiate many copy of an entity pool by pool
+ - 0.15     - Added shared component, every distinct value is stored once and query can be grouped by it
+ - 0.16     - Added parent/child hierarchy, hierarchy query visit every parent before it's children
+ - 0.17     - Added budgeted iteration so a sweep can be spread over several frame
+ - 0.18     - Added dormant entity, it's component moved into cold part of the pool and query never see it
+ - 0.19     - Added any and optional query term, field return NULL for absent optional component without lookup
+ - 0.20     - Added indexed component, find the entity by a key inside the component through hash index
+ - 0.21     - Added in-place radix/insertion sort of component pool and iteration in the pool order
+ - 0.22     - Added event channel, fixed size ring buffer with independent reader
+ - 0.23     - Added observer, added and removed entity is buffered and dispatched in batch
+ - 0.24     - Added double buffered component, system read the previous frame while writing the next one
+ - 0.25     - Added copy-on-write world fork, chunk of chunked pool is shared until one of the world write into it
+ - 0.26     - Added spawn window, id is reserved up front and handed out to many thread through atomic counter
+ - 0.27     - Added world merge, every component pool of staging world is appended as block
+ - 0.28     - Added fixed capacity world over caller buffer, full pool is reported by return value instead of growing
+ - 0.29     - Added typed component accessor generator, the mask and size is compile time constant
 
 */
 
@@ -126,12 +243,18 @@ int main()
 #ifndef RSECS_H
 #define RSECS_H
 
+// Strict C99 hide `clock_gettime` used by the default clock, asking for it only work before the first system header is included,
+// otherwise the clock fall back to `timespec_get` or `clock`
+#if defined(RSECS_IMPLEMENTATION) && !defined(RSECS_CLOCK) && !defined(_WIN32) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 199309L
+#endif
+
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #define RSECS_MAJOR_VERSION 0
-#define RSECS_MINOR_VERSION 2
+#define RSECS_MINOR_VERSION 29
 
 #ifndef RSECS_DEF
     #define RSECS_DEF
@@ -142,6 +265,38 @@ int main()
     #define RSECS_ASSERT assert
 #endif // RSECS_ASSERT
 
+#ifndef SECS_ARENA_ALIGN
+    #define SECS_ARENA_ALIGN 16
+#endif // SECS_ARENA_ALIGN
+
+/// Size in bytes of a single chunk of [`SECS_STORAGE_CHUNKED`] component pool
+#ifndef SECS_CHUNK_SIZE
+    #define SECS_CHUNK_SIZE (16 * 1024)
+#endif // SECS_CHUNK_SIZE
+
+/// Size class of [`secs_pool`] start from 16 bytes and doubled each class, anything bigger go straight to the system
+#ifndef SECS_POOL_CLASS_COUNT
+    #define SECS_POOL_CLASS_COUNT 13
+#endif // SECS_POOL_CLASS_COUNT
+
+#ifndef SECS_POOL_SLAB_SIZE
+    #define SECS_POOL_SLAB_SIZE (256 * 1024)
+#endif // SECS_POOL_SLAB_SIZE
+
+/// How many bytes [`secs_vm`] reserve for every array when it's initialized with 0
+#ifndef SECS_VM_RESERVE_SIZE
+    #if SIZE_MAX > 0xFFFFFFFFu
+        #define SECS_VM_RESERVE_SIZE ((size_t)1 << 34)
+    #else
+        #define SECS_VM_RESERVE_SIZE ((size_t)1 << 26)
+    #endif
+#endif // SECS_VM_RESERVE_SIZE
+
+/// Array of [`secs_vm`] stay on the heap until it grow past this many bytes, then it move once into it's own reserved range
+#ifndef SECS_VM_ARRAY_THRESHOLD
+    #define SECS_VM_ARRAY_THRESHOLD (64 * 1024)
+#endif // SECS_VM_ARRAY_THRESHOLD
+
 
 /// --------------------------------
 /// INFO : RSECS Contract
@@ -152,50 +307,318 @@ typedef uint64_t secs_entity_id;
 /// This component mask in allow up to 64 component in the 64-bit machine
 typedef uint64_t secs_component_mask;
 
+/// Entity id that never be spawned, used to mark something doesn't have entity
+#define SECS_ENTITY_NONE ((secs_entity_id)-1)
+
 typedef struct secs_world secs_world;
 
+/// Id of the template registered by [`secs_register_prefab`]
+typedef size_t secs_prefab_id;
+/// Id given by [`secs_register_prefab`] when the world initialized by [`secs_init_world_fixed`] has no room for the template
+#define SECS_PREFAB_NONE ((secs_prefab_id)-1)
+/// Handle of the distinct value of shared component, it start from 0 and stay valid until the world is freed
+typedef size_t secs_shared_id;
+/// Handle given by [`secs_intern_comp`] when the world initialized by [`secs_init_world_fixed`] has no room for the value
+#define SECS_SHARED_NONE ((secs_shared_id)-1)
+/// Id of the event channel registered by [`secs_register_event`]
+typedef size_t secs_event_id;
+/// Id given by [`secs_register_event`] when fixed world has no room for the channel
+#define SECS_EVENT_NONE ((secs_event_id)-1)
+
+/// Id of the observer registered by [`secs_register_observer`]
+typedef size_t secs_observer_id;
+/// Id given by [`secs_register_observer`] when fixed world has no room for the observer
+#define SECS_OBSERVER_NONE ((secs_observer_id)-1)
+
+/// What the observer react to
+typedef enum secs_observer_event {
+    /// The component is attached into the entity
+    SECS_ON_ADD = 0,
+    /// The component is removed from the entity, including when the entity is despawned
+    SECS_ON_REMOVE,
+} secs_observer_event;
+
+/// Receive every entity buffered since the last [`secs_dispatch_observers`]
+typedef void (*secs_observer_fn)(secs_world* world, const secs_entity_id* ids, size_t count, void* user_data);
+
+/// Every reader keep it's own position so many system can read the same channel
+typedef struct secs_event_reader {
+    secs_event_id   channel;
+    /// Sequence number of the next event to read
+    uint64_t        cursor;
+} secs_event_reader;
+
+/// Allocator used by every internal array of the world
+/// `alloc` is only used for block that never grow like chunk and temporary buffer,
+/// array that might grow start with `realloc` that receive NULL `ptr` when there is nothing allocated yet,
+/// and both `realloc` and `free` receive the old size so the allocator doesn't need to remember it.
+/// Returning NULL means out of memory
+typedef struct secs_allocator {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*realloc)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void  (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+    /// Set it if newly allocated or grown memory already filled with zero, so the world doesn't need to touch it
+    bool  zeroed;
+} secs_allocator;
+
+/// Linear arena, freeing individual allocation is no-op except the last one
+/// so the whole world that live inside it is thrown away by [`secs_arena_reset`]
+typedef struct secs_arena {
+    char*   base;
+    size_t  size;
+    size_t  used;
+    size_t  last;
+    bool    owned;
+} secs_arena;
+
+/// Size-class pool allocator, every class has it's own free list carved from big slab
+typedef struct secs_pool {
+    void*   free_lists[SECS_POOL_CLASS_COUNT];
+    void*   slabs;
+} secs_pool;
+
+/// Virtual memory allocator, array that grow past `SECS_VM_ARRAY_THRESHOLD` reserve [`reserve_size`] of address space
+/// and only commit page when it grow, so the base address of the big array like mask, sparse and dense is stable and nothing is copied.
+/// Small array like the entity list of every shared value and block that never grow like chunk come from the heap,
+/// so the address space doesn't run out with the amount of array
+typedef struct secs_vm {
+    size_t  reserve_size;
+    size_t  page_size;
+} secs_vm;
+
+/// How the component is stored inside the component pool
+typedef enum secs_storage {
+    /// Single array, fastest to iterate but growing the pool might move every component
+    SECS_STORAGE_CONTIGUOUS = 0,
+    /// List of `SECS_CHUNK_SIZE` chunk, the chunk memory is never reallocated so growing the pool never move existing component.
+    /// The slot still move on remove, despawn, sleep, wake, sort, compact and hierarchy query after the hierarchy changed,
+    /// and forked world copy the chunk on it's first write.
+    /// Inserting into the pool that has dormant entity move the first dormant component to the end to make room in the hot part,
+    /// so the pointer from [`secs_get_comp`] and [`secs_field`] is only valid until one of those happen
+    SECS_STORAGE_CHUNKED,
+} secs_storage;
+
+/// Parameter for registering component, use `SECS_REGISTER_COMPONENT_EX` to fill the size
+typedef struct secs_component_desc {
+    size_t          size;
+    secs_storage    storage;
+    /// Entity only keep handle to the value, equal value is stored once for the whole world
+    bool            shared;
+    /// Non zero make the component indexed by [`index_size`] bytes starting at [`index_offset`] of the component
+    /// `SECS_REGISTER_COMPONENT_EX(WORLD, NetworkId, .index_offset = offsetof(NetworkId, value), .index_size = sizeof(uint32_t))`
+    size_t          index_offset;
+    size_t          index_size;
+    /// Keep two copy of the pool, [`secs_get_comp`] and [`secs_field`] write the next frame
+    /// while [`secs_get_comp_prev`] and [`secs_field_prev`] read the previous one, only for contiguous non shared non indexed component
+    bool            double_buffered;
+    /// Hard limit of the pool in world initialized by [`secs_init_world_fixed`], 0 mean as many as the entity limit
+    size_t          capacity;
+} secs_component_desc;
+
+/// Type of the key used by [`secs_sort_comp`]
+typedef enum secs_sort_key {
+    SECS_SORT_U32 = 0,
+    SECS_SORT_I32,
+    SECS_SORT_F32,
+    SECS_SORT_U64,
+    SECS_SORT_I64,
+    SECS_SORT_F64,
+} secs_sort_key;
+
+/// Parameter for [`secs_sort_comp`]
+typedef struct secs_sort_desc {
+    /// Where the key is inside the component and it's type
+    size_t              offset;
+    secs_sort_key       key;
+    /// Use insertion sort instead of radix sort, it's almost free when the order barely change since the last sort
+    bool                nearly_sorted;
+    /// Entity of these pool that also has the sorted component is moved to the front in the same order
+    secs_component_mask co_owned;
+} secs_sort_desc;
+
 typedef struct secs_query {
     /// This will make sure that entity that has the mask be included
     secs_component_mask has;
     /// This will make sure that entity has that mask to be excluded
     secs_component_mask exclude;
+    /// Entity must have at least one of the component in this mask
+    secs_component_mask any;
+    /// Doesn't filter anything, it only tell the component might be absent so [`secs_field`] might return NULL
+    secs_component_mask optional;
+    /// Shared component to group by, only entity that has [`group_value`] will be included.
+    /// The iterator walk the entity list of that value instead of the whole id range so the order is not by id
+    secs_component_mask group;
+    secs_shared_id      group_value;
 } secs_query;
 
 typedef struct secs_query_iterator {
     secs_query      query;
     secs_world*     world;
     secs_entity_id  position;
+    /// Set by [`secs_query_iter_hierarchy`], [`cursor`] is the position inside the breadth-first order
+    bool            hierarchy;
+    size_t          cursor;
+    /// Set by [`secs_query_iter_sorted`], it's the component the iterator follow and [`cursor`] is the slot
+    secs_component_mask sorted;
+    /// Every entity is visited
+    bool            done;
+    /// Current slice of [`secs_query_iter_next_budget`]
+    bool            in_slice;
+    size_t          slice_count;
+    double          slice_start;
 } secs_query_iterator;
 
 #define SECS_INIT_WORLD(WORLD) secs_init_world(WORLD) 
 #define SECS_REGISTER_COMPONENT(WORLD, TYPE) secs_register_component((WORLD), sizeof(TYPE))
+/// Register component with extra parameter by using format
+/// `SECS_REGISTER_COMPONENT_EX(WORLD, Position, .storage = SECS_STORAGE_CHUNKED)`
+#define SECS_REGISTER_COMPONENT_EX(WORLD, TYPE, ...) secs_register_component_desc((WORLD), (secs_component_desc) {.size = sizeof(TYPE), __VA_ARGS__})
+#define SECS_REGISTER_EVENT(WORLD, TYPE, CAPACITY) secs_register_event((WORLD), sizeof(TYPE), (CAPACITY))
 /// Generate a query by using format 
 /// `SECS_CREATE_QUERY(.has = POSITION_ID, .exclude = OUT_OF_BOUND_ID)`;``
+/// `SECS_CREATE_QUERY(.has = POSITION_ID, .any = SPRITE_ID | MESH_ID, .optional = VELOCITY_ID)`;``
 #define SECS_CREATE_QUERY(...) (secs_query) {__VA_ARGS__}
 
 #define secs_query_iter_current(IT) (IT)->position
-#define secs_query_iter_reset(IT) (IT)->position = -1
+#define secs_query_iter_reset(IT) ((IT)->position = -1, (IT)->cursor = 0, (IT)->done = false, (IT)->in_slice = false)
+#define secs_query_iter_done(IT) (IT)->done
 
 
 /// Initialize the [`secs_world`] by allocating necessarily memory to it
 RSECS_DEF void secs_init_world(secs_world* world);
 /// Register the component size and return a component mask that can be used on inserting, removing, and querying
 RSECS_DEF secs_component_mask secs_register_component(secs_world* world, size_t size_component);
+/// Same as [`secs_register_component`] but with storage policy
+/// It return 0 when the buffer of fixed world can't hold the pool
+RSECS_DEF secs_component_mask secs_register_component_desc(secs_world* world, secs_component_desc desc);
 /// De-allocate all allocated memory inside the [`secs_world`]
 RSECS_DEF void secs_free_world(secs_world* world);
 /// Mark everything as empty except registered component
 RSECS_DEF void secs_reset_world(secs_world* world);
+/// Initialize the [`secs_world`] that will do all of it's allocation through [`allocator`]
+/// When using [`secs_arena`] you can skip [`secs_free_world`] and just reset the arena
+RSECS_DEF void secs_init_world_with_allocator(secs_world* world, secs_allocator allocator);
+/// Initialize the [`secs_world`] over [`buffer`] of [`size`] bytes that can hold at most [`max_entities`] living entity
+/// Registering component allocate the whole pool up front, after that spawning, attaching, removing, sleeping and parenting never allocate,
+/// full world or pool is reported by return value instead of assertion. It return false when [`buffer`] is too small
+/// Shared value, index key, observer, prefab, event, sorting and compaction still take memory from [`buffer`] but never from the system
+/// WARNING : The world keep the arena inside itself so it must not be moved, and [`secs_world_fork`] of it can't grow
+RSECS_DEF bool secs_init_world_fixed(secs_world* world, void* buffer, size_t size, size_t max_entities);
+/// Amount of bytes currently held by the world through it's allocator
+RSECS_DEF size_t secs_world_memory_usage(secs_world* world);
+/// Every entity id currently used is lower than this, use it to size the remap table of [`secs_world_compact`]
+RSECS_DEF size_t secs_world_id_range(secs_world* world);
+/// Sort every component pool by entity id for iteration locality and give back excess memory to the allocator
+/// If [`remap`] is not NULL the living entity will be renumbered densely and [`remap`] will be filled with the new id,
+/// indexed by the old id, dead entity is mapped to [`SECS_ENTITY_NONE`]. [`remap`] must hold [`secs_world_id_range`] entries
+/// WARNING : Every pointer into the component pool is invalidated
+RSECS_DEF void secs_world_compact(secs_world* world, secs_entity_id* remap);
+/// Spawn every living entity of [`src`] inside [`dst`] and copy their component pool by pool as block
+/// [`src`] must register the same component in the same order as [`dst`], it can register less
+/// Parent link, dormant entity and shared value is kept, event, prefab and observer of [`src`] is not merged
+/// The new id of `src` entity `n` is written into `remap[n]` if it's not NULL, dead id get [`SECS_ENTITY_NONE`]
+/// [`remap`] must hold [`secs_world_id_range`] of [`src`], and [`src`] itself is not modified
+/// It return false and leave [`dst`] as it is when [`dst`] is fixed world that can't hold everything
+RSECS_DEF bool secs_world_merge(secs_world* dst, secs_world* src, secs_entity_id* remap);
+/// Initialize [`child`] as a copy of [`parent`] through the parent allocator, nothing is copied until one of them write into it.
+/// Every pool is copied as a whole by the first write into that pool except the chunk of [`SECS_STORAGE_CHUNKED`] pool that is copied one by one,
+/// the entity, the hierarchy, the event and the observer is copied the same way on their own, only the prefab is copied right away.
+/// Discard the fork with [`secs_free_world`], the parent can be freed before it's fork.
+/// [`secs_get_comp`], [`secs_field`] and every structural change count as writing, use [`secs_peek_comp`] and [`secs_peek_field`] to read
+/// WARNING : Pointer into a component of shared pool is only valid until the next write access of that world, and the parent and it's fork must stay in one thread
+RSECS_DEF void secs_world_fork(secs_world* parent, secs_world* child);
+
+/// Allocator that use `RSTB_DA_REALLOC` and `RSTB_DA_FREE`, this is what [`secs_init_world`] use
+RSECS_DEF secs_allocator secs_default_allocator(void);
+/// Initialize the arena over [`buffer`], if [`buffer`] is NULL the arena will allocate [`size`] bytes by itself
+RSECS_DEF void secs_arena_init(secs_arena* arena, void* buffer, size_t size);
+/// Mark the whole arena as unused, everything allocated from it is gone
+RSECS_DEF void secs_arena_reset(secs_arena* arena);
+/// Free the arena buffer if the arena allocate it by itself
+RSECS_DEF void secs_arena_free(secs_arena* arena);
+/// Get the allocator interface of the arena, the arena must outlive the world
+RSECS_DEF secs_allocator secs_arena_allocator(secs_arena* arena);
+/// Initialize the size-class pool
+RSECS_DEF void secs_pool_init(secs_pool* pool);
+/// Give back every slab owned by the pool to the system
+RSECS_DEF void secs_pool_free(secs_pool* pool);
+/// Get the allocator interface of the pool, the pool must outlive the world
+RSECS_DEF secs_allocator secs_pool_allocator(secs_pool* pool);
+#ifndef RSECS_NO_VIRTUAL_MEMORY
+/// Initialize the virtual memory allocator, [`reserve_size`] is the address space reserved per big array
+/// pass 0 to use `SECS_VM_RESERVE_SIZE`
+RSECS_DEF void secs_vm_init(secs_vm* vm, size_t reserve_size);
+/// Get the allocator interface of the virtual memory allocator, the [`secs_vm`] must outlive the world
+RSECS_DEF secs_allocator secs_vm_allocator(secs_vm* vm);
+#endif // RSECS_NO_VIRTUAL_MEMORY
 
 /// Spawning an entity and doing some chore to setup the world to accomodate new entity
-/// It might be use old entity id
+/// It will reuse the lowest despawned entity id first so living entity stay packed
+/// Fixed world return [`SECS_ENTITY_NONE`] when it already hold [`max_entities`] entity
 RSECS_DEF secs_entity_id secs_spawn(secs_world* world);
-/// Remove the entity id from active entity
+/// Remove the entity id from active entity, despawning the highest entity id will shrink the world
 RSECS_DEF void secs_despawn(secs_world* world, secs_entity_id id);
 
+/// Open a spawn window of [`count`] id so many thread can spawn at the same time, dead id is recycled first
+/// Until [`secs_spawn_end`] the only thing allowed to change the world is [`secs_spawn_concurrent`],
+/// so attach the component after the window is closed
+RSECS_DEF void secs_spawn_begin(secs_world* world, size_t count);
+/// Take the next id of the spawn window, it's safe to call from many thread at the same time
+/// It return [`SECS_ENTITY_NONE`] when every reserved id is already taken
+RSECS_DEF secs_entity_id secs_spawn_concurrent(secs_world* world);
+/// Take up to [`count`] id of the spawn window with a single atomic operation and return how many is written into [`ids`]
+/// Worker thread can take a block once and spawn from it without touching the shared counter again
+RSECS_DEF size_t secs_spawn_concurrent_many(secs_world* world, size_t count, secs_entity_id* ids);
+/// Close the spawn window, the id nobody took is despawned again
+RSECS_DEF void secs_spawn_end(secs_world* world);
+/// Despawn [`count`] entity at once, every component pool is visited once for all of them
+RSECS_DEF void secs_despawn_many(secs_world* world, const secs_entity_id* ids, size_t count);
+/// Despawn every entity that match the [`query`] and return how many entity despawned
+/// It's safe to use instead of calling [`secs_despawn`] while iterating
+RSECS_DEF size_t secs_despawn_query(secs_world* world, secs_query query);
+
+/// Attach the [`child`] under the [`parent`], it will be detached from it's old parent first
+/// Passing [`SECS_ENTITY_NONE`] as [`parent`] make it a root again, it return false when fixed world can't hold the link
+RSECS_DEF bool secs_set_parent(secs_world* world, secs_entity_id child, secs_entity_id parent);
+/// Same as [`secs_set_parent`] for [`count`] entity, the breadth-first order is only rebuilt once
+RSECS_DEF bool secs_set_parent_many(secs_world* world, const secs_entity_id* children, size_t count, secs_entity_id parent);
+/// Get the parent of the entity, it return [`SECS_ENTITY_NONE`] when it's a root
+RSECS_DEF secs_entity_id secs_get_parent(secs_world* world, secs_entity_id id);
+/// Despawn the entity and every descendant in one [`secs_despawn_many`]
+/// Despawning only the parent with [`secs_despawn`] turn it's children into root
+RSECS_DEF void secs_despawn_tree(secs_world* world, secs_entity_id root);
+
+/// Make the entity dormant, every component of it is moved into the cold part of it's pool
+/// so query skip it without testing it, [`secs_get_comp`] and inserting component still work
+/// WARNING : Once the pool has dormant entity, inserting into it move the component of a dormant entity even in chunked pool
+RSECS_DEF void secs_sleep(secs_world* world, secs_entity_id id);
+/// Move the component of dormant entity back so query can see it again, it cost one swap per component
+RSECS_DEF void secs_wake(secs_world* world, secs_entity_id id);
+/// Check if the entity is put to sleep by [`secs_sleep`]
+RSECS_DEF bool secs_is_dormant(secs_world* world, secs_entity_id id);
+
+/// Snapshot every component of the entity so it can be spawned again and again
+/// The entity itself is not touched, so it can be despawned after this, fixed world give [`SECS_PREFAB_NONE`] when it's full
+RSECS_DEF secs_prefab_id secs_register_prefab(secs_world* world, secs_entity_id id);
+/// Spawn [`count`] entity that has the same component as the prefab, and write their id into [`ids`] if it's not NULL
+/// The component is copied pool by pool as block
+/// It return false without spawning anything when fixed world can't hold them
+RSECS_DEF bool secs_instantiate(secs_world* world, secs_prefab_id prefab, size_t count, secs_entity_id* ids);
+
 /// Insert a generic component into component pool by copying by value
-/// It will also overwrite if it already exist
+/// It will also overwrite if it already exist, it return false when the pool of fixed world is full
 /// WARNING : Avoid using `|` (Bit OR) when passing the mask IT WILL CAUSE UNDEFINED BEHAVIOR
-RSECS_DEF void secs_insert_comp(secs_world* world, secs_entity_id id, secs_component_mask mask, void* component);
+RSECS_DEF bool secs_insert_comp(secs_world* world, secs_entity_id id, secs_component_mask mask, void* component);
+/// Attach a component into entity without copying anything and return the slot so it can be initialized in place
+/// If the entity already has it, it will return the existing component, it doesn't work for shared component
+/// It return NULL when the pool of fixed world is full
+/// WARNING : The slot content is garbage when it's newly attached
+RSECS_DEF void* secs_emplace_comp(secs_world* world, secs_entity_id id, secs_component_mask mask);
+/// Attach a component into [`count`] entity at once and return contiguous slot, the n-th slot belong to `ids[n]`
+/// None of the entity may already have it, and the component must use [`SECS_STORAGE_CONTIGUOUS`]
+/// It return NULL without attaching anything when the pool of fixed world is full
+RSECS_DEF void* secs_emplace_comp_many(secs_world* world, const secs_entity_id* ids, size_t count, secs_component_mask mask);
 
 /// Check if entity has component mask
 RSECS_DEF bool secs_has_comp(secs_world* world, secs_entity_id id, secs_component_mask mask);
@@ -204,22 +627,105 @@ RSECS_DEF bool secs_has_not_comp(secs_world* world, secs_entity_id id, secs_comp
 
 /// Mark component on that entity id as garbage
 RSECS_DEF void secs_remove_comp(secs_world* world, secs_entity_id id, secs_component_mask mask);
+/// Insert [`count`] component from [`components`] array into the entity with the same index by copying by value
+/// Every array only reserved once and the component copied in one pass if none of the entity already has it
+/// It return false when the pool of fixed world is full, some of the entity might already get it
+RSECS_DEF bool secs_insert_comp_many(secs_world* world, const secs_entity_id* ids, size_t count, secs_component_mask mask, const void* components);
+/// Remove the component from [`count`] entity
+RSECS_DEF void secs_remove_comp_many(secs_world* world, const secs_entity_id* ids, size_t count, secs_component_mask mask);
+/// Remove the component from every entity, it cost as much as the amount of entity that has it
+RSECS_DEF void secs_clear_comp(secs_world* world, secs_component_mask mask);
 
 /// Get generic component from entity id, if it doesn't find it will fail at assertion
 /// You will also need to cast into appropriate type, and it will return NULL if it doesn't have
+/// Shared component give the interned value which must not be modified, insert the new value instead
 /// WARNING : Avoid using `|` (Bit OR) when passing the mask IT WILL CAUSE UNDEFINED BEHAVIOR
 RSECS_DEF void* secs_get_comp(secs_world* world, secs_entity_id id, secs_component_mask mask);
+/// Same as [`secs_get_comp`] but the component must not be modified, so chunk shared with the fork is never copied
+RSECS_DEF const void* secs_peek_comp(secs_world* world, secs_entity_id id, secs_component_mask mask);
+/// Get the previous frame side of double buffered component, it return NULL if it doesn't have any
+/// It's never written until [`secs_swap_buffers`] so other thread can read it while the next frame is written
+RSECS_DEF const void* secs_get_comp_prev(secs_world* world, secs_entity_id id, secs_component_mask mask);
+/// Flip the two side of every double buffered component, it only swap the pointer so it's O(1) per pool
+/// The next frame side then hold what was written two frame ago, so system should write every component it own each frame
+RSECS_DEF void secs_swap_buffers(secs_world* world);
+
+/// Find the handle of the value of shared component, the value is stored if no entity ever had it
+/// [`secs_insert_comp`] on shared component intern the value by itself, fixed world give [`SECS_SHARED_NONE`] when it's full
+RSECS_DEF secs_shared_id secs_intern_comp(secs_world* world, secs_component_mask mask, const void* value);
+/// How many distinct value the shared component has, every handle is lower than this
+RSECS_DEF size_t secs_shared_count(secs_world* world, secs_component_mask mask);
+/// Get the value of shared component from it's handle
+/// WARNING : The pointer is invalidated when new value is interned
+RSECS_DEF const void* secs_shared_value(secs_world* world, secs_component_mask mask, secs_shared_id handle);
+
+/// Sort the component pool in place by the key inside the component, smallest first
+/// Radix sort is used unless `.nearly_sorted` is set, then the co-owned pool follow the same order
+/// Use [`secs_query_iter_sorted`] to iterate in that order, dormant entity is not sorted
+/// It return false without moving anything when fixed world can't hold the scratch memory
+/// WARNING : Every pointer into the sorted pool and the co-owned pool is invalidated
+RSECS_DEF bool secs_sort_comp(secs_world* world, secs_component_mask mask, secs_sort_desc desc);
+
+/// Register event channel that can hold [`capacity`] event of [`size`] bytes, the memory is allocated once in here
+/// Fixed world give [`SECS_EVENT_NONE`] when it can't hold the channel
+RSECS_DEF secs_event_id secs_register_event(secs_world* world, size_t size, size_t capacity);
+/// Copy the event into the channel, when the channel is full the oldest event is dropped
+RSECS_DEF void secs_send_event(secs_world* world, secs_event_id channel, const void* event);
+/// Same as [`secs_send_event`] but return the slot so the event can be written in place
+/// WARNING : The slot content is garbage
+RSECS_DEF void* secs_emit_event(secs_world* world, secs_event_id channel);
+/// Create a reader that will start from the oldest event still in the channel
+RSECS_DEF secs_event_reader secs_event_reader_init(secs_world* world, secs_event_id channel);
+/// Point [`events`] into the next contiguous run of unread event and return how many event in it, 0 when there is nothing left
+/// The run stop where the ring buffer wrap around so call it in a loop. Reader that fall behind skip the dropped event
+RSECS_DEF size_t secs_read_events(secs_world* world, secs_event_reader* reader, const void** events);
+/// Drop every event that was sent before the previous update, so every event can be read for a whole frame
+/// no matter the order of the system, call it once per frame
+RSECS_DEF void secs_update_events(secs_world* world);
+
+/// Buffer the entity every time one of the [`mask`] component is added into or removed from it
+/// Nothing is called until [`secs_dispatch_observers`] so reacting cost as much as the amount of change
+/// Fixed world give [`SECS_OBSERVER_NONE`] when it's full, and buffer at most as many entity as it's limit per dispatch
+RSECS_DEF secs_observer_id secs_register_observer(secs_world* world, secs_component_mask mask, secs_observer_event event, secs_observer_fn callback, void* user_data);
+/// Call every observer that has buffered entity, the entity is reported once per component so it might be reported more than once
+/// Removed entity might be already despawned. Change made inside the callback is reported on the next dispatch
+RSECS_DEF void secs_dispatch_observers(secs_world* world);
+
+/// Find the entity which indexed component has the [`key`], it return [`SECS_ENTITY_NONE`] if nobody has it
+/// If many entity has the same key any of them might be returned
+/// WARNING : The index only follow [`secs_insert_comp`], changing the key through the pointer make it stale
+RSECS_DEF secs_entity_id secs_index_find(secs_world* world, secs_component_mask mask, const void* key);
 
 
 /// Create a query iterator from the query, and setup the iteration data based on the [`world`] and [`secs_query`] struct
 RSECS_DEF secs_query_iterator secs_query_iter(secs_world* world, secs_query query);
+/// Same as [`secs_query_iter`] but the entity is visited in breadth-first order of the hierarchy,
+/// root first then sorted by depth, so every parent is visited before it's children. Entity without parent and children come last.
+/// The first one after the hierarchy changed reorder every pool the same way so walking the hierarchy walk the component forward
+/// WARNING : Changing the hierarchy while iterating is not visible until the next iterator
+/// WARNING : Reordering invalidate pointer into the pool like [`secs_sort_comp`] and undo it's order for entity inside the hierarchy
+RSECS_DEF secs_query_iterator secs_query_iter_hierarchy(secs_world* world, secs_query query);
+/// Same as [`secs_query_iter`] but the entity is visited in the order of [`mask`] component pool,
+/// which is the order given by [`secs_sort_comp`], only the entity that has the component is visited
+/// WARNING : Inserting or removing [`mask`] component while iterating might skip or repeat entity
+RSECS_DEF secs_query_iterator secs_query_iter_sorted(secs_world* world, secs_query query, secs_component_mask mask);
 /// Advance the iterator
 RSECS_DEF bool secs_query_iter_next(secs_query_iterator* it);
-/// Get the component from corresponding iterator
+/// Advance the iterator like [`secs_query_iter_next`] but return false once [`max_entities`] entity is visited
+/// or [`max_seconds`] passed since the first call of this slice, pass 0 to not limit either of them.
+/// The next call start a new slice and resume where it stop, use [`secs_query_iter_done`] to know if the sweep is finished.
+/// The iterator is safe to keep between frame, entity spawned with higher id is visited and despawned entity is skipped
+/// WARNING : Keep the iterator in the same world, [`secs_world_compact`] with remap make it skip or repeat entity
+/// WARNING : Freestanding build need `RSECS_CLOCK` to use [`max_seconds`], it assert otherwise
+RSECS_DEF bool secs_query_iter_next_budget(secs_query_iterator* it, size_t max_entities, double max_seconds);
+/// Get the component from corresponding iterator, it return NULL when the entity doesn't have it like `.any` or `.optional` term
 /// WARNING : Avoid using `|` (Bit OR) when passing the mask IT WILL CAUSE UNDEFINED BEHAVIOR
 RSECS_DEF void* secs_field(secs_query_iterator* it, secs_component_mask mask);
+/// Same as [`secs_field`] but the component must not be modified, so chunk shared with the fork is never copied
+RSECS_DEF const void* secs_peek_field(secs_query_iterator* it, secs_component_mask mask);
+/// Get the previous frame side of double buffered component from corresponding iterator
+RSECS_DEF const void* secs_field_prev(secs_query_iterator* it, secs_component_mask mask);
 
-#ifdef RSECS_IMPLEMENTATION
 /// --------------------------------
 /// INFO : I'm lazy okay for creating dynamic array
 /// --------------------------------
@@ -316,6 +822,239 @@ Dynamic Array (da) for C by using macro system.
 
 #endif // RSTB_DA_H
 
+/// --------------------------------
+/// INFO : RSECS Storage Layout
+/// --------------------------------
+
+// Every file see the layout so typed accessor of [`SECS_DECLARE_COMPONENT`] can index the pool directly,
+// it's still internal so only read it through the API
+
+rstb_da_decl(char, secs_comp_chunk)
+rstb_da_decl(secs_entity_id, secs_entity_chunk)
+rstb_da_decl(secs_component_mask, secs_comp_mask_chunk)
+rstb_da_decl(char*, secs_chunk_dir)
+rstb_da_decl(uint64_t, secs_bit_chunk)
+rstb_da_decl(size_t, secs_index_chunk)
+rstb_da_decl(secs_entity_chunk, secs_group_chunk)
+
+// Two level bitset, every bit in the summary tell if the 64-bit word is not empty
+typedef struct secs_bitset {
+    secs_bit_chunk  words;
+    secs_bit_chunk  summary;
+    // How many bit is set
+    size_t          count;
+    // No summary word below this one has any bit set
+    size_t          hint;
+} secs_bitset;
+
+typedef struct secs_comp_list {
+    // The size of the component inside the dense array
+    size_t size_of_component;
+    // How many component inside the pool
+    size_t count;
+
+    // Component of awake entity is in front, the dormant one is from this index until [`count`]
+    size_t hot;
+    // Hard limit of fixed world, 0 mean the pool can grow
+    size_t capacity;
+
+    secs_storage        storage;
+    // How many component fit in a single chunk
+    size_t              per_chunk;
+
+    // Used by SECS_STORAGE_CONTIGUOUS
+    secs_comp_chunk     dense;
+    // Used by SECS_STORAGE_CHUNKED, growing only move this directory not the chunk
+    secs_chunk_dir      chunks;
+    // Some chunk might be shared with another world by [`secs_world_fork`], writing need to check it's reference count
+    bool                forked;
+    // Map entity id into the index of the component
+    secs_entity_chunk   sparse;
+    // Map the index of the component back into entity id
+    secs_entity_chunk   entities;
+    // Bit per entity that has this component, used by the query
+    secs_bitset         present;
+
+    // Shared component store `secs_shared_id` in the pool and the value itself in here
+    bool                shared;
+    size_t              value_size;
+    // Every distinct value packed
+    secs_comp_chunk     values;
+    // Open addressing hash table of the handle + 1, 0 mean empty
+    secs_index_chunk    table;
+    // Entity that has the value, one list per handle so the memory follow the entity count instead of the id range
+    secs_group_chunk    groups;
+    // Map entity id into it's position inside the list of it's value
+    secs_entity_chunk   grouped;
+
+    // Indexed component hash the key inside the component, 0 size mean it's not indexed
+    size_t              key_offset;
+    size_t              key_size;
+    // Open addressing hash table of the entity id + 1, 0 mean empty
+    secs_index_chunk    index;
+    size_t              indexed;
+
+    // Double buffered pool mirror every slot of [`dense`] in here, [`secs_swap_buffers`] swap the two array
+    bool                double_buffered;
+    secs_comp_chunk     prev;
+
+    // How many world use every array above since [`secs_world_fork`], NULL mean this world is the only one
+    size_t*             refs;
+} secs_comp_list;
+
+rstb_da_decl(secs_comp_list, secs_comp_list_chunk)
+
+typedef struct secs_prefab {
+    secs_component_mask mask;
+    // Every component of the template packed in the component index order
+    secs_comp_chunk     data;
+} secs_prefab;
+
+rstb_da_decl(secs_prefab, secs_prefab_chunk)
+
+typedef struct secs_event_channel {
+    size_t          size;
+    size_t          capacity;
+    secs_comp_chunk buffer;
+    // Sequence number of the next event to be written, the event is at `sequence % capacity`
+    uint64_t        head;
+    // Sequence number of the oldest event
+    uint64_t        tail;
+    // The head at the last update
+    uint64_t        mark;
+} secs_event_channel;
+
+rstb_da_decl(secs_event_channel, secs_event_chunk)
+
+typedef struct secs_observer {
+    secs_component_mask mask;
+    secs_observer_event event;
+    secs_observer_fn    callback;
+    void*               user_data;
+    // Entity waiting to be dispatched
+    secs_entity_chunk   pending;
+} secs_observer;
+
+rstb_da_decl(secs_observer, secs_observer_chunk)
+
+// Every link store the entity id + 1 so 0 mean nothing, indexed by entity id
+typedef struct secs_hierarchy {
+    secs_entity_chunk   parent;
+    secs_entity_chunk   first_child;
+    secs_entity_chunk   next_sibling;
+    secs_entity_chunk   prev_sibling;
+    // Entity that has parent or children, root first and then sorted by depth
+    secs_entity_chunk   order;
+    // The order need to be rebuilt before the next hierarchy query
+    bool                dirty;
+    // Shared with fork like the array of the component pool
+    size_t*             refs;
+} secs_hierarchy;
+
+struct secs_world {
+    size_t component_mask;
+
+    secs_comp_list_chunk lists;
+    // The count is also the next fresh entity id
+    secs_comp_mask_chunk mask;
+    // Despawned entity id waiting to be reused
+    secs_bitset          dead;
+    // Entity put to sleep, only needed by query that doesn't have any component
+    secs_bitset          dormant;
+    // How many world use [`mask`], [`dead`] and [`dormant`] since [`secs_world_fork`], NULL mean this world is the only one
+    size_t*              entity_refs;
+    secs_prefab_chunk    prefabs;
+    secs_hierarchy       hierarchy;
+    secs_event_chunk     events;
+    size_t*              event_refs;
+    secs_observer_chunk  observers;
+    size_t*              observer_refs;
+    // Every component that has observer, so the component pool can skip looking for them
+    secs_component_mask  observed[2];
+    // Id reserved by [`secs_spawn_begin`], [`spawn_cursor`] is the next one to hand out
+    secs_entity_chunk    spawn_window;
+    size_t               spawn_cursor;
+    bool                 spawning;
+
+    secs_allocator allocator;
+    size_t         bytes_allocated;
+
+    // Set by [`secs_init_world_fixed`], every allocation come from [`fixed_arena`] and entity can't go beyond [`max_entities`]
+    bool           fixed;
+    size_t         max_entities;
+    secs_arena     fixed_arena;
+};
+
+/// Mask of the component declared by [`SECS_DECLARE_COMPONENT`], it's constant so it can be used in query and switch
+#define SECS_COMP_MASK(TYPE) ((secs_component_mask)1 << secs_##TYPE##_order)
+/// Generate typed accessor of [`TYPE`] that is registered as the [`ORDER`]-th component of the world, starting from 0
+/// `SECS_DECLARE_COMPONENT(Position, 1)` then `secs_register_Position(&world)`, `secs_insert_Position(&world, id, (Position) {0})`,
+/// `secs_get_Position`, `secs_peek_Position`, `secs_has_Position`, `secs_remove_Position` and `secs_field_Position(&it)`
+/// The accessor go straight into the pool [`ORDER`] with `sizeof(TYPE)` as constant from every file and the component is copied by assignment,
+/// only attaching, removing and writing into pool shared with a fork go through the `void*` API
+/// The pool can be contiguous, chunked, double buffered or indexed, use [`secs_register_component_desc`] and the `void*` API for shared one
+#define SECS_DECLARE_COMPONENT(TYPE, ORDER) \
+    enum { secs_##TYPE##_order = (ORDER) }; \
+    static inline secs_component_mask secs_register_##TYPE(secs_world* world) \
+    { \
+        secs_component_mask mask = secs_register_component(world, sizeof(TYPE)); \
+        RSECS_ASSERT((mask == 0 || mask == SECS_COMP_MASK(TYPE)) && "Component is registered in different order than it's declared"); \
+        return mask; \
+    } \
+    _SECS_DECLARE_ACCESSOR(TYPE)
+
+// Same as `per_chunk` of the pool but known at compile time
+#define _SECS_TYPED_PER_CHUNK(TYPE) (sizeof(TYPE) > SECS_CHUNK_SIZE ? 1 : SECS_CHUNK_SIZE / sizeof(TYPE))
+#define _SECS_TYPED_AT(TYPE, COMP, SLOT) \
+    ((COMP)->storage == SECS_STORAGE_CHUNKED \
+        ? (TYPE*)(COMP)->chunks.items[(SLOT) / _SECS_TYPED_PER_CHUNK(TYPE)] + (SLOT) % _SECS_TYPED_PER_CHUNK(TYPE) \
+        : (TYPE*)(COMP)->dense.items + (SLOT))
+#define _SECS_DECLARE_ACCESSOR(TYPE) \
+    static inline secs_comp_list* __secs_##TYPE##_pool(secs_world* world) \
+    { \
+        RSECS_ASSERT((size_t)secs_##TYPE##_order + 1 < world->lists.count && "Component is not registered yet"); \
+        secs_comp_list* comp = &world->lists.items[secs_##TYPE##_order + 1]; \
+        /* Shared pool hold the handle of the value, not the value itself */ \
+        RSECS_ASSERT(!comp->shared && "Shared component has no typed accessor, use the void* API"); \
+        return comp; \
+    } \
+    static inline bool secs_has_##TYPE(secs_world* world, secs_entity_id id) \
+    { \
+        RSECS_ASSERT(world->mask.count > id && "Entity is not found"); \
+        return (world->mask.items[id] & SECS_COMP_MASK(TYPE)) != 0; \
+    } \
+    static inline TYPE* secs_get_##TYPE(secs_world* world, secs_entity_id id) \
+    { \
+        if (!secs_has_##TYPE(world, id)) return NULL; \
+        secs_comp_list* comp = __secs_##TYPE##_pool(world); \
+        /* Pool or chunk shared with a fork has to be copied first */ \
+        if (comp->refs != NULL || comp->forked) return (TYPE*)secs_get_comp(world, id, SECS_COMP_MASK(TYPE)); \
+        return _SECS_TYPED_AT(TYPE, comp, comp->sparse.items[id]); \
+    } \
+    static inline const TYPE* secs_peek_##TYPE(secs_world* world, secs_entity_id id) \
+    { \
+        if (!secs_has_##TYPE(world, id)) return NULL; \
+        secs_comp_list* comp = __secs_##TYPE##_pool(world); \
+        return _SECS_TYPED_AT(TYPE, comp, comp->sparse.items[id]); \
+    } \
+    static inline bool secs_insert_##TYPE(secs_world* world, secs_entity_id id, TYPE value) \
+    { \
+        /* Overwriting indexed component has to move it inside the index too */ \
+        TYPE* slot = __secs_##TYPE##_pool(world)->key_size == 0 ? secs_get_##TYPE(world, id) : NULL; \
+        if (slot == NULL) return secs_insert_comp(world, id, SECS_COMP_MASK(TYPE), &value); \
+        *slot = value; \
+        return true; \
+    } \
+    static inline void secs_remove_##TYPE(secs_world* world, secs_entity_id id) \
+    { \
+        secs_remove_comp(world, id, SECS_COMP_MASK(TYPE)); \
+    } \
+    static inline TYPE* secs_field_##TYPE(secs_query_iterator* it) \
+    { \
+        return secs_get_##TYPE(it->world, it->position); \
+    }
+
+#ifdef RSECS_IMPLEMENTATION
 /// --------------------------------
 /// INFO : RSECS Main Implementation
 /// --------------------------------
@@ -324,11 +1063,42 @@ Dynamic Array (da) for C by using macro system.
 #include <string.h>
 #include <stddef.h>
 
-#define _SECS_GET_OFFSET(BASE, INDEX, SIZE) ((char*)BASE) + ((INDEX) * (SIZE))
+// Freestanding build has no clock, only the time budget of `secs_query_iter_next_budget` need one
+#if !defined(RSECS_CLOCK) && (defined(_WIN32) || __STDC_HOSTED__)
+    #define RSECS_CLOCK __secs_clock
+    #define _SECS_DEFAULT_CLOCK
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <time.h>
+    #endif
+#endif // RSECS_CLOCK
+
+// Return the old value, the spawn window is filled before any thread start so relaxed order is enough
+#ifndef RSECS_ATOMIC_ADD
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #ifdef _WIN64
+            #define RSECS_ATOMIC_ADD(PTR, VALUE) (size_t)_InterlockedExchangeAdd64((volatile long long*)(PTR), (long long)(VALUE))
+        #else
+            #define RSECS_ATOMIC_ADD(PTR, VALUE) (size_t)_InterlockedExchangeAdd((volatile long*)(PTR), (long)(VALUE))
+        #endif
+    #else
+        #define RSECS_ATOMIC_ADD(PTR, VALUE) __atomic_fetch_add((PTR), (VALUE), __ATOMIC_RELAXED)
+    #endif
+#endif // RSECS_ATOMIC_ADD
 
-rstb_da_decl(char, secs_comp_chunk);
-rstb_da_decl(secs_entity_id, secs_entity_chunk);
-rstb_da_decl(secs_component_mask, secs_comp_mask_chunk);
+#ifndef RSECS_NO_VIRTUAL_MEMORY
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <sys/mman.h>
+        #include <unistd.h>
+        #include <fcntl.h>
+    #endif
+#endif // RSECS_NO_VIRTUAL_MEMORY
+
+#define _SECS_GET_OFFSET(BASE, INDEX, SIZE) ((char*)BASE) + ((INDEX) * (SIZE))
 
 // Pre-compute index array based on the component mask
 static secs_component_mask _secs_comp_map[64] = {
@@ -398,225 +1168,3091 @@ static secs_component_mask _secs_comp_map[64] = {
     (secs_component_mask)0x1 << 62,
 };
 
-typedef struct secs_comp_list {
-    // The size of the component inside the dense array
-    size_t size_of_component;
-
-    secs_comp_chunk     dense;
-    secs_entity_chunk   sparse;
-} secs_comp_list;
 
-rstb_da_decl(secs_comp_list, secs_comp_list_chunk);
+/// --------------------------------
+/// INFO : Allocator
+/// --------------------------------
 
-struct secs_world {
-    size_t component_mask;
-    size_t next_entity_id;
+static void* __secs_default_alloc(void* ctx, size_t size)
+{
+    (void)ctx;
+    return RSTB_DA_REALLOC(NULL, size);
+}
 
-    secs_comp_list_chunk lists;
-    secs_comp_mask_chunk mask;
-    secs_entity_chunk    dead;
-};
+static void* __secs_default_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    (void)ctx;
+    (void)old_size;
+    return RSTB_DA_REALLOC(ptr, new_size);
+}
 
-static size_t __secs_get_comp_from_bitmask(secs_component_mask mask)
+static void __secs_default_free(void* ctx, void* ptr, size_t size)
 {
-    int low = 0;
-    int high = (sizeof(_secs_comp_map)/sizeof(_secs_comp_map[0])) - 1;
-    while (low <= high) {
-        int mid = low + (high - low) / 2;
-        if (_secs_comp_map[mid] == mask) {
-            return mid;
-        } else if (_secs_comp_map[mid] < mask) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
-    RSECS_ASSERT(0 && "UNREACHABLE");
-    return 0;
+    (void)ctx;
+    (void)size;
+    RSTB_DA_FREE(ptr);
 }
 
-RSECS_DEF void secs_init_world(secs_world* world)
+RSECS_DEF secs_allocator secs_default_allocator(void)
 {
-    memset(world, 0, sizeof(secs_world));
-    world->component_mask = 1;
+    return (secs_allocator) {
+        .alloc = __secs_default_alloc,
+        .realloc = __secs_default_realloc,
+        .free = __secs_default_free,
+        .ctx = NULL,
+    };
 }
 
-RSECS_DEF secs_component_mask secs_register_component(secs_world* world, size_t size_component)
+static void* __secs_arena_alloc(void* ctx, size_t size)
 {
-    secs_component_mask temp = world->component_mask;
-    size_t index = __secs_get_comp_from_bitmask(temp);
-    rstb_da_reserve(&(world)->lists, index + 1);
-    world->lists.items[index].size_of_component = size_component;
-    world->component_mask = world->component_mask << 1;
-    return temp;
+    secs_arena* arena = ctx;
+    size_t start = (arena->used + SECS_ARENA_ALIGN - 1) & ~((size_t)SECS_ARENA_ALIGN - 1);
+    if (start > arena->size || size > arena->size - start) return NULL;
+    arena->last = start;
+    arena->used = start + size;
+    return arena->base + start;
 }
 
-RSECS_DEF void secs_free_world(secs_world* world)
+static void* __secs_arena_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
 {
-    rstb_da_free(&world->mask);
-    rstb_da_free(&world->dead);
-    rstb_da_foreach(secs_comp_list, x, &world->lists) {
-        rstb_da_free(&x->dense);
-        rstb_da_free(&x->sparse);
+    secs_arena* arena = ctx;
+    if (ptr == NULL) return __secs_arena_alloc(ctx, new_size);
+    // The last allocation can grow in place
+    if ((char*)ptr == arena->base + arena->last && new_size <= arena->size - arena->last) {
+        arena->used = arena->last + new_size;
+        return ptr;
     }
-    rstb_da_free(&world->lists);
+    void* result = __secs_arena_alloc(ctx, new_size);
+    if (result == NULL) return NULL;
+    memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+    return result;
 }
 
-RSECS_DEF void secs_reset_world(secs_world* world)
+static void __secs_arena_free(void* ctx, void* ptr, size_t size)
 {
-    world->mask.count = 0;
-    world->dead.count = 0;
-    rstb_da_foreach(secs_comp_list, x, &world->lists) {
-        x->dense.count = 0;
-        x->sparse.count = 0;
+    (void)size;
+    secs_arena* arena = ctx;
+    if (ptr != NULL && (char*)ptr == arena->base + arena->last) {
+        arena->used = arena->last;
     }
 }
 
-RSECS_DEF secs_entity_id secs_spawn(secs_world* world)
+RSECS_DEF void secs_arena_init(secs_arena* arena, void* buffer, size_t size)
+{
+    memset(arena, 0, sizeof(secs_arena));
+    arena->owned = buffer == NULL;
+    arena->base = arena->owned ? RSTB_DA_REALLOC(NULL, size) : buffer;
+    RSECS_ASSERT(arena->base && "Buy more RAM lol");
+    arena->size = size;
+}
+
+RSECS_DEF void secs_arena_reset(secs_arena* arena)
+{
+    arena->used = 0;
+    arena->last = 0;
+}
+
+RSECS_DEF void secs_arena_free(secs_arena* arena)
+{
+    if (arena->owned) RSTB_DA_FREE(arena->base);
+    memset(arena, 0, sizeof(secs_arena));
+}
+
+RSECS_DEF secs_allocator secs_arena_allocator(secs_arena* arena)
+{
+    return (secs_allocator) {
+        .alloc = __secs_arena_alloc,
+        .realloc = __secs_arena_realloc,
+        .free = __secs_arena_free,
+        .ctx = arena,
+    };
+}
+
+// Return SECS_POOL_CLASS_COUNT if it's too big for the pool
+static size_t __secs_pool_class(size_t size)
 {
-    if (world->dead.count > 0) {
-        secs_entity_id id = world->dead.items[0];
-        rstb_da_remove_unordered(&world->dead, 0);
-        world->mask.items[id] = 0;
-        return id;
+    size_t size_class = 0;
+    size_t class_size = 16;
+    while (class_size < size && size_class < SECS_POOL_CLASS_COUNT) {
+        class_size <<= 1;
+        size_class += 1;
     }
-    secs_entity_id id = world->next_entity_id++;
-    rstb_da_reserve(&world->mask, id + 1);
-    world->mask.count += 1;
-    return id;
+    return size_class;
 }
 
-RSECS_DEF void secs_despawn(secs_world* world, secs_entity_id id)
+static void* __secs_pool_alloc(void* ctx, size_t size)
 {
-    RSECS_ASSERT(world->mask.count > id && "Entity is not found");
-    for (size_t i = 0; i < 64; i++) {
-        if (secs_has_comp(world, id, _secs_comp_map[i])) {
-            secs_remove_comp(world, id, _secs_comp_map[i]);
+    secs_pool* pool = ctx;
+    size_t size_class = __secs_pool_class(size);
+    if (size_class >= SECS_POOL_CLASS_COUNT) return RSTB_DA_REALLOC(NULL, size);
+
+    if (pool->free_lists[size_class] == NULL) {
+        // The first block of the slab is used to link all the slab together
+        size_t block_size = (size_t)16 << size_class;
+        size_t slab_size = SECS_POOL_SLAB_SIZE < block_size * 2 ? block_size * 2 : SECS_POOL_SLAB_SIZE;
+        char* slab = RSTB_DA_REALLOC(NULL, slab_size);
+        if (slab == NULL) return NULL;
+        *(void**)slab = pool->slabs;
+        pool->slabs = slab;
+        for (size_t offset = block_size; offset + block_size <= slab_size; offset += block_size) {
+            *(void**)(slab + offset) = pool->free_lists[size_class];
+            pool->free_lists[size_class] = slab + offset;
         }
     }
-    world->mask.items[id] = 0;
-    rstb_da_append(&world->dead, id);
+
+    void* block = pool->free_lists[size_class];
+    pool->free_lists[size_class] = *(void**)block;
+    return block;
 }
 
-RSECS_DEF void secs_insert_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id, void* component)
+static void __secs_pool_free(void* ctx, void* ptr, size_t size)
 {
-    size_t index = __secs_get_comp_from_bitmask(component_id);
-    RSECS_ASSERT(index < world->lists.capacity && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
-    secs_comp_list* comp = &world->lists.items[index];
-    if (secs_has_comp(world, entity_id, component_id)) {
-        memcpy(
-            _SECS_GET_OFFSET(comp->dense.items, comp->sparse.items[entity_id], comp->size_of_component), 
-            component, 
-            comp->size_of_component
-        );
+    secs_pool* pool = ctx;
+    if (ptr == NULL) return;
+    size_t size_class = __secs_pool_class(size);
+    if (size_class >= SECS_POOL_CLASS_COUNT) {
+        RSTB_DA_FREE(ptr);
         return;
     }
-    rstb_da_reserve(&(comp->sparse), entity_id + 1);
-    comp->sparse.items[entity_id] = comp->dense.count;
-    comp->dense.count += 1;
-    rstb_da_reserve(&(comp->dense), comp->dense.count * comp->size_of_component);
-    memcpy(
-        _SECS_GET_OFFSET(comp->dense.items, comp->sparse.items[entity_id], comp->size_of_component), 
-        component, 
-        comp->size_of_component
-    );
-    world->mask.items[entity_id] |= component_id;
+    *(void**)ptr = pool->free_lists[size_class];
+    pool->free_lists[size_class] = ptr;
 }
 
-RSECS_DEF bool secs_has_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+static void* __secs_pool_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
 {
-    RSECS_ASSERT(world->mask.count > entity_id && "Entity is not found");
-    return (world->mask.items[entity_id] & component_id) == component_id;
+    if (ptr == NULL) return __secs_pool_alloc(ctx, new_size);
+    size_t old_class = __secs_pool_class(old_size);
+    size_t new_class = __secs_pool_class(new_size);
+    if (old_class == new_class && new_class < SECS_POOL_CLASS_COUNT) return ptr;
+    if (old_class >= SECS_POOL_CLASS_COUNT && new_class >= SECS_POOL_CLASS_COUNT) return RSTB_DA_REALLOC(ptr, new_size);
+
+    void* result = __secs_pool_alloc(ctx, new_size);
+    if (result == NULL) return NULL;
+    memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+    __secs_pool_free(ctx, ptr, old_size);
+    return result;
 }
 
-RSECS_DEF bool secs_has_not_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+RSECS_DEF void secs_pool_init(secs_pool* pool)
 {
-    RSECS_ASSERT(world->mask.count > entity_id && "Entity is not found");
-    return (world->mask.items[entity_id] & component_id) == 0;
+    memset(pool, 0, sizeof(secs_pool));
 }
 
-RSECS_DEF void secs_remove_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+RSECS_DEF void secs_pool_free(secs_pool* pool)
 {
-    size_t index = __secs_get_comp_from_bitmask(component_id);
-    RSECS_ASSERT(index < world->lists.capacity && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
-    if (!secs_has_comp(world, entity_id, component_id)) return;
-    world->mask.items[entity_id] &= ~component_id;
+    while (pool->slabs != NULL) {
+        void* next = *(void**)pool->slabs;
+        RSTB_DA_FREE(pool->slabs);
+        pool->slabs = next;
+    }
+    memset(pool, 0, sizeof(secs_pool));
+}
 
-    // TODO : Make this much more efficient
-    secs_comp_list* comp = &world->lists.items[index];
-    for (size_t i = 0; i < comp->sparse.capacity; i++) {
-        if (comp->sparse.items[i] == comp->dense.count - 1) {
-            memmove(
-                _SECS_GET_OFFSET(comp->dense.items, comp->sparse.items[entity_id], comp->size_of_component), 
-                _SECS_GET_OFFSET(comp->dense.items, comp->dense.count - 1, comp->size_of_component),
-                comp->size_of_component
-            );
-            comp->sparse.items[i] = comp->sparse.items[entity_id];
-            comp->sparse.items[entity_id] = 0;
-            comp->dense.count -= 1;
-            return;
-        }
+RSECS_DEF secs_allocator secs_pool_allocator(secs_pool* pool)
+{
+    return (secs_allocator) {
+        .alloc = __secs_pool_alloc,
+        .realloc = __secs_pool_realloc,
+        .free = __secs_pool_free,
+        .ctx = pool,
+    };
+}
+
+#ifndef RSECS_NO_VIRTUAL_MEMORY
+
+#ifdef _WIN32
+static size_t __secs_vm_page_size(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+static void* __secs_vm_reserve(size_t size)
+{
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static bool __secs_vm_commit(void* ptr, size_t size)
+{
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+static void __secs_vm_decommit(void* ptr, size_t size)
+{
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+}
+
+static void __secs_vm_release(void* ptr, size_t size)
+{
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+#else
+static size_t __secs_vm_page_size(void)
+{
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// Strict C99 doesn't have MAP_ANONYMOUS so fallback into mapping /dev/zero
+static void* __secs_vm_map(void* ptr, size_t size, int flags)
+{
+#if defined(MAP_ANONYMOUS)
+    void* result = mmap(ptr, size, PROT_NONE, flags | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#elif defined(MAP_ANON)
+    void* result = mmap(ptr, size, PROT_NONE, flags | MAP_PRIVATE | MAP_ANON, -1, 0);
+#else
+    int fd = open("/dev/zero", O_RDWR);
+    if (fd < 0) return NULL;
+    void* result = mmap(ptr, size, PROT_NONE, flags | MAP_PRIVATE, fd, 0);
+    close(fd);
+#endif
+    return result == MAP_FAILED ? NULL : result;
+}
+
+static void* __secs_vm_reserve(size_t size)
+{
+    return __secs_vm_map(NULL, size, 0);
+}
+
+static bool __secs_vm_commit(void* ptr, size_t size)
+{
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+// Mapping fresh page on top of it give the memory back and it will be zero when committed again
+static void __secs_vm_decommit(void* ptr, size_t size)
+{
+    __secs_vm_map(ptr, size, MAP_FIXED);
+}
+
+static void __secs_vm_release(void* ptr, size_t size)
+{
+    munmap(ptr, size);
+}
+#endif // _WIN32
+
+// Every block has the header right before it, big array has it at the end of the first page of the reserved range
+// while small array and fixed size block come from the heap and [`base`] is NULL
+typedef struct __secs_vm_header {
+    char*  base;
+    size_t reserved;
+    size_t committed;
+    size_t padding;
+} __secs_vm_header;
+
+static size_t __secs_vm_round(secs_vm* vm, size_t size)
+{
+    return (size + vm->page_size - 1) / vm->page_size * vm->page_size;
+}
+
+// Big array take the whole [`reserve_size`] of address space
+static void* __secs_vm_reserve_array(secs_vm* vm, size_t size)
+{
+    size_t committed = __secs_vm_round(vm, size);
+    size_t reserved = committed > vm->reserve_size ? committed : vm->reserve_size;
+    char* base = __secs_vm_reserve(vm->page_size + reserved);
+    if (base == NULL) return NULL;
+    if (!__secs_vm_commit(base, vm->page_size + committed)) {
+        __secs_vm_release(base, vm->page_size + reserved);
+        return NULL;
     }
+    __secs_vm_header* header = (__secs_vm_header*)(base + vm->page_size) - 1;
+    header->base = base;
+    header->reserved = reserved;
+    header->committed = committed;
+    return base + vm->page_size;
 }
 
-RSECS_DEF void* secs_get_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+// Chunk and scratch buffer never grow, reserving the whole range for them only run out of address space
+// so they're taken from the heap at their exact size
+static void* __secs_vm_alloc(void* ctx, size_t size)
 {
-    size_t index = __secs_get_comp_from_bitmask(component_id);
-    RSECS_ASSERT(index < world->lists.capacity && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
-    if (!secs_has_comp(world, entity_id, component_id)) return NULL;
+    (void)ctx;
+    __secs_vm_header* header = RSTB_DA_REALLOC(NULL, sizeof(__secs_vm_header) + size);
+    if (header == NULL) return NULL;
+    memset(header, 0, sizeof(__secs_vm_header) + size);
+    header->reserved = size;
+    header->committed = size;
+    return header + 1;
+}
 
-    secs_comp_list* comp = &world->lists.items[index];
-    if (comp->sparse.capacity > entity_id) {
-        size_t index = comp->sparse.items[entity_id];
-        return _SECS_GET_OFFSET(comp->dense.items, index, comp->size_of_component);
+static void __secs_vm_free(void* ctx, void* ptr, size_t size)
+{
+    (void)size;
+    secs_vm* vm = ctx;
+    if (ptr == NULL) return;
+    __secs_vm_header* header = (__secs_vm_header*)ptr - 1;
+    if (header->base == NULL) {
+        RSTB_DA_FREE(header);
+        return;
+    }
+    __secs_vm_release(header->base, vm->page_size + header->reserved);
+}
+
+static void* __secs_vm_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    secs_vm* vm = ctx;
+    if (ptr == NULL) {
+        return new_size < SECS_VM_ARRAY_THRESHOLD ? __secs_vm_alloc(ctx, new_size) : __secs_vm_reserve_array(vm, new_size);
+    }
+    __secs_vm_header* header = (__secs_vm_header*)ptr - 1;
+    size_t committed = __secs_vm_round(vm, new_size);
+
+    // Heap block only shrink in place, the tail is cleared so growing back still give zero
+    if (header->base == NULL && new_size <= header->reserved) {
+        if (new_size < old_size) memset((char*)ptr + new_size, 0, old_size - new_size);
+        return ptr;
+    }
+
+    // Small array keep growing on the heap like any other array
+    if (header->base == NULL && new_size < SECS_VM_ARRAY_THRESHOLD) {
+        size_t old_reserved = header->reserved;
+        header = RSTB_DA_REALLOC(header, sizeof(__secs_vm_header) + new_size);
+        if (header == NULL) return NULL;
+        memset((char*)(header + 1) + old_reserved, 0, new_size - old_reserved);
+        header->reserved = new_size;
+        header->committed = new_size;
+        return header + 1;
+    }
+
+    // Outgrow the reserved range or heap block that become big, this is the only time it need to copy
+    if (header->base == NULL || committed > header->reserved) {
+        void* result = __secs_vm_reserve_array(vm, new_size);
+        if (result == NULL) return NULL;
+        memcpy(result, ptr, old_size);
+        __secs_vm_free(ctx, ptr, old_size);
+        return result;
     }
-    return NULL;
+
+    if (committed > header->committed) {
+        if (!__secs_vm_commit((char*)ptr + header->committed, committed - header->committed)) return NULL;
+    } else if (committed < header->committed) {
+        __secs_vm_decommit((char*)ptr + committed, header->committed - committed);
+    }
+    // Keep the promise that grown memory is zero, the decommitted page already zero
+    if (new_size < old_size) {
+        size_t end = old_size < committed ? old_size : committed;
+        if (end > new_size) memset((char*)ptr + new_size, 0, end - new_size);
+    }
+    header->committed = committed;
+    return ptr;
 }
 
+RSECS_DEF void secs_vm_init(secs_vm* vm, size_t reserve_size)
+{
+    memset(vm, 0, sizeof(secs_vm));
+    vm->page_size = __secs_vm_page_size();
+    vm->reserve_size = __secs_vm_round(vm, reserve_size == 0 ? SECS_VM_RESERVE_SIZE : reserve_size);
+}
 
-RSECS_DEF secs_query_iterator secs_query_iter(secs_world* world, secs_query query)
+RSECS_DEF secs_allocator secs_vm_allocator(secs_vm* vm)
 {
-     return (secs_query_iterator) {
-        .query = query,
-        .world = world,
-        .position = (uint64_t)-1,
+    return (secs_allocator) {
+        .alloc = __secs_vm_alloc,
+        .realloc = __secs_vm_realloc,
+        .free = __secs_vm_free,
+        .ctx = vm,
+        .zeroed = true,
     };
 }
 
-RSECS_DEF bool secs_query_iter_next(secs_query_iterator* it)
+#endif // RSECS_NO_VIRTUAL_MEMORY
+
+/// Same as `rstb_da_reserve` but going through the world allocator, it return false when out of memory
+static bool __secs_da_grow(secs_world* world, void** items, size_t* capacity, size_t item_size, size_t expected)
 {
-    while (it->world->mask.count > it->position + 1) {
-        it->position++;
-        if (secs_has_comp(it->world, it->position, it->query.has) && secs_has_not_comp(it->world, it->position, it->query.exclude)) {
-            return true;
-        }
+    size_t old = *capacity;
+    size_t new_capacity = old == 0 ? RSTB_DA_INIT_CAP : old;
+    while (expected > new_capacity) {
+        new_capacity *= 2;
     }
-    return false;
+    void* result = world->allocator.realloc(world->allocator.ctx, *items, old * item_size, new_capacity * item_size);
+    if (result == NULL) return false;
+    if (!world->allocator.zeroed) {
+        memset((char*)result + old * item_size, 0, (new_capacity - old) * item_size);
+    }
+    world->bytes_allocated += (new_capacity - old) * item_size;
+    *items = result;
+    *capacity = new_capacity;
+    return true;
 }
-RSECS_DEF void* secs_field(secs_query_iterator* it, secs_component_mask mask)
+
+static void __secs_da_release(secs_world* world, void** items, size_t* capacity, size_t item_size)
 {
-    return secs_get_comp(it->world, it->position, mask);
+    if (*items != NULL) {
+        world->allocator.free(world->allocator.ctx, *items, *capacity * item_size);
+        world->bytes_allocated -= *capacity * item_size;
+    }
+    *items = NULL;
+    *capacity = 0;
 }
 
+#define _secs_da_try_reserve(WORLD, DA, EXPECTED) \
+    ((EXPECTED) <= (DA)->capacity || __secs_da_grow((WORLD), (void**)&(DA)->items, &(DA)->capacity, sizeof(*(DA)->items), (EXPECTED)))
 
-#endif //RSECS_IMPLEMENTATION
+#define _secs_da_reserve(WORLD, DA, EXPECTED) \
+    do { \
+        if (!_secs_da_try_reserve((WORLD), (DA), (EXPECTED))) { \
+            RSECS_ASSERT(0 && "Buy more RAM lol"); \
+        } \
+    } while (0)
 
-#ifdef RSECS_STRIP_PREFIX
-    #define INIT_WORLD(WORLD) SECS_INIT_WORLD(WORLD)
+#define _secs_da_append(WORLD, DA, VALUE) \
+    do { \
+        _secs_da_reserve((WORLD), (DA), (DA)->count + 1); \
+        (DA)->items[(DA)->count++] = VALUE; \
+    } while (0)
+
+#define _secs_da_free(WORLD, DA) \
+    do { \
+        __secs_da_release((WORLD), (void**)&(DA)->items, &(DA)->capacity, sizeof(*(DA)->items)); \
+        (DA)->count = 0; \
+    } while (0)
+
+// Give back the excess capacity, it's fine if the allocator refuse since the old memory is still valid
+static void __secs_da_shrink(secs_world* world, void** items, size_t* capacity, size_t item_size, size_t count)
+{
+    // Fixed world keep every array at it's limit so it never need to grow again
+    if (count >= *capacity || world->fixed) return;
+    if (count == 0) {
+        __secs_da_release(world, items, capacity, item_size);
+        return;
+    }
+    void* result = world->allocator.realloc(world->allocator.ctx, *items, *capacity * item_size, count * item_size);
+    if (result == NULL) return;
+    world->bytes_allocated -= (*capacity - count) * item_size;
+    *items = result;
+    *capacity = count;
+}
+
+#define _secs_da_shrink(WORLD, DA, COUNT) \
+    __secs_da_shrink((WORLD), (void**)&(DA)->items, &(DA)->capacity, sizeof(*(DA)->items), (COUNT))
+
+// Allocate the exact same capacity and copy the whole array, the destination must not own anything yet
+static void __secs_da_clone(secs_world* world, void** items, size_t* capacity, const void* source, size_t source_capacity, size_t item_size)
+{
+    *items = NULL;
+    *capacity = 0;
+    if (source == NULL || source_capacity == 0) return;
+    *items = world->allocator.alloc(world->allocator.ctx, source_capacity * item_size);
+    RSECS_ASSERT(*items && "Buy more RAM lol");
+    memcpy(*items, source, source_capacity * item_size);
+    world->bytes_allocated += source_capacity * item_size;
+    *capacity = source_capacity;
+}
+
+#define _secs_da_clone(WORLD, DST, SRC) \
+    do { \
+        __secs_da_clone((WORLD), (void**)&(DST)->items, &(DST)->capacity, (SRC)->items, (SRC)->capacity, sizeof(*(DST)->items)); \
+        (DST)->count = (SRC)->count; \
+    } while (0)
+
+// Array shared by [`secs_world_fork`] is counted by every world that use it, like the chunk
+typedef enum __secs_cow_op {
+    // The fork start counting the array it got from the parent
+    _SECS_COW_ADOPT,
+    // Stop counting the array that another world still use
+    _SECS_COW_FORGET,
+    // Replace the array with a private copy of the same capacity, so the amount counted doesn't change
+    _SECS_COW_COPY,
+} __secs_cow_op;
+
+static void __secs_cow_array(secs_world* world, void** items, size_t* capacity, size_t item_size, __secs_cow_op op)
+{
+    size_t bytes = *capacity * item_size;
+    if (op == _SECS_COW_ADOPT) {
+        world->bytes_allocated += bytes;
+        return;
+    }
+    if (op == _SECS_COW_COPY) {
+        __secs_da_clone(world, items, capacity, *items, *capacity, item_size);
+    }
+    world->bytes_allocated -= bytes;
+}
+
+#define _secs_cow_da(WORLD, DA, OP) \
+    __secs_cow_array((WORLD), (void**)&(DA)->items, &(DA)->capacity, sizeof(*(DA)->items), (OP))
+
+// Add one more world to the reference count, the count is allocated at the first fork and isn't counted as world memory
+static void __secs_cow_share(secs_world* world, size_t** refs)
+{
+    if (*refs == NULL) {
+        *refs = world->allocator.alloc(world->allocator.ctx, sizeof(size_t));
+        RSECS_ASSERT(*refs && "Buy more RAM lol");
+        **refs = 1;
+    }
+    **refs += 1;
+}
+
+// Remove the world from the reference count, it return true when nobody else use the arrays anymore
+static bool __secs_cow_drop(secs_world* world, size_t** refs)
+{
+    if (*refs == NULL) return true;
+    **refs -= 1;
+    bool last = **refs == 0;
+    if (last) world->allocator.free(world->allocator.ctx, *refs, sizeof(size_t));
+    *refs = NULL;
+    return last;
+}
+
+// The world has to copy the arrays before writing into them when this return true
+static bool __secs_cow_shared(secs_world* world, size_t** refs)
+{
+    if (*refs == NULL) return false;
+    if (**refs > 1) return true;
+    // Every other world is gone so the arrays belong to this one again
+    __secs_cow_drop(world, refs);
+    return false;
+}
+
+/// --------------------------------
+/// INFO : Bitset
+/// --------------------------------
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#define _SECS_NO_BIT SIZE_MAX
+
+static uint64_t __secs_bitset_word(secs_bitset* bitset, size_t word)
+{
+    return word < bitset->words.capacity ? bitset->words.items[word] : 0;
+}
+
+static uint64_t __secs_bitset_summary(secs_bitset* bitset, size_t summary)
+{
+    return summary < bitset->summary.capacity ? bitset->summary.items[summary] : 0;
+}
+
+static size_t __secs_ctz64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+#else
+    size_t index = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        index += 1;
+    }
+    return index;
+#endif
+}
+
+static bool __secs_bitset_reserve(secs_world* world, secs_bitset* bitset, size_t bits)
+{
+    size_t words = (bits + 63) / 64;
+    return _secs_da_try_reserve(world, &bitset->words, words)
+        && _secs_da_try_reserve(world, &bitset->summary, (words + 63) / 64);
+}
+
+static bool __secs_bitset_test(secs_bitset* bitset, size_t bit)
+{
+    if (bit / 64 >= bitset->words.capacity) return false;
+    return (bitset->words.items[bit / 64] >> (bit % 64)) & 1;
+}
+
+// The bitset must be reserved first
+static void __secs_bitset_set(secs_bitset* bitset, size_t bit)
+{
+    uint64_t* word = &bitset->words.items[bit / 64];
+    if (*word & ((uint64_t)1 << (bit % 64))) return;
+    *word |= (uint64_t)1 << (bit % 64);
+    bitset->summary.items[bit / 4096] |= (uint64_t)1 << ((bit / 64) % 64);
+    bitset->count += 1;
+    if (bit / 4096 < bitset->hint) bitset->hint = bit / 4096;
+}
+
+static void __secs_bitset_clear(secs_bitset* bitset, size_t bit)
+{
+    if (!__secs_bitset_test(bitset, bit)) return;
+    uint64_t* word = &bitset->words.items[bit / 64];
+    *word &= ~((uint64_t)1 << (bit % 64));
+    if (*word == 0) {
+        bitset->summary.items[bit / 4096] &= ~((uint64_t)1 << ((bit / 64) % 64));
+    }
+    bitset->count -= 1;
+}
+
+// Return `_SECS_NO_BIT` if the bitset is empty
+static size_t __secs_bitset_first(secs_bitset* bitset)
+{
+    if (bitset->count == 0) return _SECS_NO_BIT;
+    while (bitset->summary.items[bitset->hint] == 0) {
+        bitset->hint += 1;
+    }
+    size_t word = bitset->hint * 64 + __secs_ctz64(bitset->summary.items[bitset->hint]);
+    return word * 64 + __secs_ctz64(bitset->words.items[word]);
+}
+
+static void __secs_bitset_reset(secs_bitset* bitset)
+{
+    if (bitset->words.items) memset(bitset->words.items, 0, bitset->words.capacity * sizeof(uint64_t));
+    if (bitset->summary.items) memset(bitset->summary.items, 0, bitset->summary.capacity * sizeof(uint64_t));
+    bitset->count = 0;
+    bitset->hint = 0;
+}
+
+static void __secs_bitset_shrink(secs_world* world, secs_bitset* bitset, size_t bits)
+{
+    size_t words = (bits + 63) / 64;
+    _secs_da_shrink(world, &bitset->words, words);
+    _secs_da_shrink(world, &bitset->summary, (words + 63) / 64);
+    if (bitset->hint >= bitset->summary.capacity) bitset->hint = 0;
+}
+
+static void __secs_bitset_free(secs_world* world, secs_bitset* bitset)
+{
+    _secs_da_free(world, &bitset->words);
+    _secs_da_free(world, &bitset->summary);
+    bitset->count = 0;
+    bitset->hint = 0;
+}
+
+/// --------------------------------
+/// INFO : Component pool storage
+/// --------------------------------
+
+static size_t __secs_chunk_bytes(secs_comp_list* comp)
+{
+    size_t bytes = comp->per_chunk * comp->size_of_component;
+    return bytes == 0 ? 1 : bytes;
+}
+
+// Every chunk is prefixed by it's reference count, the header keep the component aligned like the allocator does
+#define _SECS_CHUNK_HEADER SECS_ARENA_ALIGN
+
+static size_t* __secs_chunk_refs(char* chunk)
+{
+    return (size_t*)(chunk - _SECS_CHUNK_HEADER);
+}
+
+static char* __secs_chunk_alloc(secs_world* world, secs_comp_list* comp)
+{
+    char* base = world->allocator.alloc(world->allocator.ctx, _SECS_CHUNK_HEADER + __secs_chunk_bytes(comp));
+    if (base == NULL) return NULL;
+    world->bytes_allocated += _SECS_CHUNK_HEADER + __secs_chunk_bytes(comp);
+    *(size_t*)base = 1;
+    return base + _SECS_CHUNK_HEADER;
+}
+
+// Shared chunk is counted by every world that use it, the last one free it
+static void __secs_chunk_release(secs_world* world, secs_comp_list* comp, char* chunk)
+{
+    world->bytes_allocated -= _SECS_CHUNK_HEADER + __secs_chunk_bytes(comp);
+    size_t* refs = __secs_chunk_refs(chunk);
+    *refs -= 1;
+    if (*refs == 0) {
+        world->allocator.free(world->allocator.ctx, chunk - _SECS_CHUNK_HEADER, _SECS_CHUNK_HEADER + __secs_chunk_bytes(comp));
+    }
+}
+
+// Visit every array of the pool, the list of the shared value is visited after the array holding them is copied
+static void __secs_comp_cow(secs_world* world, secs_comp_list* comp, __secs_cow_op op)
+{
+    _secs_cow_da(world, &comp->dense, op);
+    _secs_cow_da(world, &comp->prev, op);
+    _secs_cow_da(world, &comp->sparse, op);
+    _secs_cow_da(world, &comp->entities, op);
+    _secs_cow_da(world, &comp->present.words, op);
+    _secs_cow_da(world, &comp->present.summary, op);
+    _secs_cow_da(world, &comp->values, op);
+    _secs_cow_da(world, &comp->table, op);
+    _secs_cow_da(world, &comp->index, op);
+    _secs_cow_da(world, &comp->grouped, op);
+    _secs_cow_da(world, &comp->groups, op);
+    rstb_da_foreach(secs_entity_chunk, group, &comp->groups) {
+        _secs_cow_da(world, group, op);
+    }
+    // Only the directory is copied, the chunk is shared by both directory from now on
+    _secs_cow_da(world, &comp->chunks, op);
+    size_t chunk_bytes = comp->chunks.count * (_SECS_CHUNK_HEADER + __secs_chunk_bytes(comp));
+    if (op == _SECS_COW_ADOPT) world->bytes_allocated += chunk_bytes;
+    if (op == _SECS_COW_FORGET) world->bytes_allocated -= chunk_bytes;
+    if (op == _SECS_COW_COPY) {
+        rstb_da_foreach(char*, chunk, &comp->chunks) {
+            *__secs_chunk_refs(*chunk) += 1;
+        }
+        comp->forked = comp->forked || comp->chunks.count > 0;
+    }
+}
+
+// Must be called before anything of the pool is written, the pool is copied if a fork still use it
+static void __secs_comp_unshare(secs_world* world, secs_comp_list* comp)
+{
+    if (!__secs_cow_shared(world, &comp->refs)) return;
+    __secs_comp_cow(world, comp, _SECS_COW_COPY);
+    __secs_cow_drop(world, &comp->refs);
+}
+
+static void __secs_entity_cow(secs_world* world, __secs_cow_op op)
+{
+    _secs_cow_da(world, &world->mask, op);
+    _secs_cow_da(world, &world->dead.words, op);
+    _secs_cow_da(world, &world->dead.summary, op);
+    _secs_cow_da(world, &world->dormant.words, op);
+    _secs_cow_da(world, &world->dormant.summary, op);
+}
+
+// Same as [`__secs_comp_unshare`] for the entity mask, [`dead`] and [`dormant`]
+static void __secs_entity_unshare(secs_world* world)
+{
+    if (!__secs_cow_shared(world, &world->entity_refs)) return;
+    __secs_entity_cow(world, _SECS_COW_COPY);
+    __secs_cow_drop(world, &world->entity_refs);
+}
+
+static void __secs_hierarchy_cow(secs_world* world, __secs_cow_op op)
+{
+    _secs_cow_da(world, &world->hierarchy.parent, op);
+    _secs_cow_da(world, &world->hierarchy.first_child, op);
+    _secs_cow_da(world, &world->hierarchy.next_sibling, op);
+    _secs_cow_da(world, &world->hierarchy.prev_sibling, op);
+    _secs_cow_da(world, &world->hierarchy.order, op);
+}
+
+static void __secs_hierarchy_unshare(secs_world* world)
+{
+    if (!__secs_cow_shared(world, &world->hierarchy.refs)) return;
+    __secs_hierarchy_cow(world, _SECS_COW_COPY);
+    __secs_cow_drop(world, &world->hierarchy.refs);
+}
+
+static void __secs_event_cow(secs_world* world, __secs_cow_op op)
+{
+    _secs_cow_da(world, &world->events, op);
+    rstb_da_foreach(secs_event_channel, channel, &world->events) {
+        _secs_cow_da(world, &channel->buffer, op);
+    }
+}
+
+static void __secs_event_unshare(secs_world* world)
+{
+    if (!__secs_cow_shared(world, &world->event_refs)) return;
+    __secs_event_cow(world, _SECS_COW_COPY);
+    __secs_cow_drop(world, &world->event_refs);
+}
+
+static void __secs_observer_cow(secs_world* world, __secs_cow_op op)
+{
+    _secs_cow_da(world, &world->observers, op);
+    rstb_da_foreach(secs_observer, observer, &world->observers) {
+        _secs_cow_da(world, &observer->pending, op);
+    }
+}
+
+static void __secs_observer_unshare(secs_world* world)
+{
+    if (!__secs_cow_shared(world, &world->observer_refs)) return;
+    __secs_observer_cow(world, _SECS_COW_COPY);
+    __secs_cow_drop(world, &world->observer_refs);
+}
+
+// Copy every shared chunk that hold slot [`first`] until [`first`] + [`count`] so the world can write into it
+// It return false when the allocator is out of memory
+static bool __secs_comp_own(secs_world* world, secs_comp_list* comp, size_t first, size_t count)
+{
+    __secs_comp_unshare(world, comp);
+    if (!comp->forked || count == 0) return true;
+    size_t last = (first + count - 1) / comp->per_chunk;
+    for (size_t c = first / comp->per_chunk; c <= last && c < comp->chunks.count; c++) {
+        char* chunk = comp->chunks.items[c];
+        if (*__secs_chunk_refs(chunk) == 1) continue;
+        char* copy = __secs_chunk_alloc(world, comp);
+        if (copy == NULL) return false;
+        memcpy(copy, chunk, __secs_chunk_bytes(comp));
+        __secs_chunk_release(world, comp, chunk);
+        comp->chunks.items[c] = copy;
+    }
+    return true;
+}
+
+static void* __secs_comp_at(secs_comp_list* comp, size_t index)
+{
+    if (comp->storage == SECS_STORAGE_CHUNKED) {
+        return comp->chunks.items[index / comp->per_chunk] + (index % comp->per_chunk) * comp->size_of_component;
+    }
+    return _SECS_GET_OFFSET(comp->dense.items, index, comp->size_of_component);
+}
+
+// Previous frame side of the slot, only valid for double buffered pool
+static void* __secs_comp_prev_at(secs_comp_list* comp, size_t index)
+{
+    return _SECS_GET_OFFSET(comp->prev.items, index, comp->size_of_component);
+}
+
+static secs_shared_id __secs_shared_handle(secs_comp_list* comp, size_t index)
+{
+    return *(secs_shared_id*)__secs_comp_at(comp, index);
+}
+
+// Make room for [`count`] more entity in the list of [`handle`] and the position of entity below [`id_range`]
+static bool __secs_group_reserve(secs_world* world, secs_comp_list* comp, secs_shared_id handle, size_t count, size_t id_range)
+{
+    secs_entity_chunk* group = &comp->groups.items[handle];
+    return _secs_da_try_reserve(world, group, group->count + count)
+        && _secs_da_try_reserve(world, &comp->grouped, id_range);
+}
+
+// The list must be reserved first
+static void __secs_group_add(secs_comp_list* comp, secs_shared_id handle, secs_entity_id id)
+{
+    secs_entity_chunk* group = &comp->groups.items[handle];
+    comp->grouped.items[id] = group->count;
+    group->items[group->count++] = id;
+}
+
+// Fill the hole with the last entity of the list
+static void __secs_group_remove(secs_comp_list* comp, secs_shared_id handle, secs_entity_id id)
+{
+    secs_entity_chunk* group = &comp->groups.items[handle];
+    size_t position = comp->grouped.items[id];
+    secs_entity_id last = group->items[--group->count];
+    group->items[position] = last;
+    comp->grouped.items[last] = position;
+}
+
+// The entity must have the component
+static void* __secs_comp_get(secs_comp_list* comp, secs_entity_id id)
+{
+    size_t slot = comp->sparse.items[id];
+    if (comp->shared) return comp->values.items + __secs_shared_handle(comp, slot) * comp->value_size;
+    return __secs_comp_at(comp, slot);
+}
+
+// Same as above but the component is going to be modified, shared value is never modified in place
+static void* __secs_comp_get_mut(secs_world* world, secs_comp_list* comp, secs_entity_id id)
+{
+    if (!comp->shared && !__secs_comp_own(world, comp, comp->sparse.items[id], 1)) {
+        RSECS_ASSERT(0 && "Buy more RAM lol");
+    }
+    return __secs_comp_get(comp, id);
+}
+
+// FNV-1a, the value is usually small so it's good enough
+static uint64_t __secs_hash(const void* data, size_t size)
+{
+    const unsigned char* bytes = data;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static size_t __secs_index_home(secs_comp_list* comp, secs_entity_id id)
+{
+    const char* key = (const char*)__secs_comp_get(comp, id) + comp->key_offset;
+    return __secs_hash(key, comp->key_size) % comp->index.capacity;
+}
+
+static void __secs_index_put(secs_comp_list* comp, secs_entity_id id)
+{
+    size_t i = __secs_index_home(comp, id);
+    while (comp->index.items[i] != 0) {
+        i = (i + 1) % comp->index.capacity;
+    }
+    comp->index.items[i] = id + 1;
+}
+
+// Index every entity of the pool again, the table is kept at most half full
+static void __secs_index_rebuild(secs_world* world, secs_comp_list* comp)
+{
+    comp->indexed = 0;
+    // Fixed world size the table at registration so it's only cleared
+    if (world->fixed) {
+        if (comp->index.items) memset(comp->index.items, 0, comp->index.capacity * sizeof(size_t));
+    } else {
+        _secs_da_free(world, &comp->index);
+        if (comp->count == 0) return;
+        _secs_da_reserve(world, &comp->index, comp->count * 2);
+    }
+    for (size_t slot = 0; slot < comp->count; slot++) {
+        __secs_index_put(comp, comp->entities.items[slot]);
+    }
+    comp->indexed = comp->count;
+}
+
+// The component of the entity must already be written
+static void __secs_index_add(secs_world* world, secs_comp_list* comp, secs_entity_id id)
+{
+    if ((comp->indexed + 1) * 2 > comp->index.capacity) {
+        __secs_index_rebuild(world, comp);
+        return;
+    }
+    __secs_index_put(comp, id);
+    comp->indexed += 1;
+}
+
+// Index [`count`] entity that is just pushed into the pool, when the table has to grow the rebuild already index all of them
+static void __secs_index_add_many(secs_world* world, secs_comp_list* comp, const secs_entity_id* ids, size_t count)
+{
+    if (comp->key_size == 0 || count == 0) return;
+    if ((comp->indexed + count) * 2 > comp->index.capacity) {
+        __secs_index_rebuild(world, comp);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        __secs_index_put(comp, ids[i]);
+    }
+    comp->indexed += count;
+}
+
+// Remove the entry then shift the next entry of the same cluster back so lookup never stop too early
+static void __secs_index_remove(secs_comp_list* comp, secs_entity_id id)
+{
+    if (comp->index.capacity == 0) return;
+    size_t capacity = comp->index.capacity;
+    size_t hole = __secs_index_home(comp, id);
+    while (comp->index.items[hole] != id + 1) {
+        if (comp->index.items[hole] == 0) return;
+        hole = (hole + 1) % capacity;
+    }
+    for (size_t next = (hole + 1) % capacity; comp->index.items[next] != 0; next = (next + 1) % capacity) {
+        size_t home = __secs_index_home(comp, comp->index.items[next] - 1);
+        // Only move it if it's home is not between the hole and where it is now
+        bool stay = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (stay) continue;
+        comp->index.items[hole] = comp->index.items[next];
+        hole = next;
+    }
+    comp->index.items[hole] = 0;
+    comp->indexed -= 1;
+}
+
+// Copy [`count`] component from [`data`] into the pool starting from [`first`], one memcpy per chunk
+static void __secs_comp_write(secs_comp_list* comp, size_t first, const void* data, size_t count)
+{
+    const char* source = data;
+    if (comp->double_buffered) {
+        memcpy(__secs_comp_prev_at(comp, first), data, count * comp->size_of_component);
+    }
+    while (count > 0) {
+        size_t run = count;
+        if (comp->storage == SECS_STORAGE_CHUNKED) {
+            size_t left = comp->per_chunk - first % comp->per_chunk;
+            if (run > left) run = left;
+        }
+        memcpy(__secs_comp_at(comp, first), source, run * comp->size_of_component);
+        source += run * comp->size_of_component;
+        first += run;
+        count -= run;
+    }
+}
+
+// Copy the same component into [`count`] slot starting from [`first`], the copied block keep doubling in size
+static void __secs_comp_fill(secs_comp_list* comp, size_t first, const void* value, size_t count)
+{
+    size_t size = comp->size_of_component;
+    if (count == 0) return;
+    if (comp->storage == SECS_STORAGE_CHUNKED) {
+        for (size_t i = 0; i < count; i++) {
+            memcpy(__secs_comp_at(comp, first + i), value, size);
+        }
+        return;
+    }
+    char* base = __secs_comp_at(comp, first);
+    memcpy(base, value, size);
+    size_t done = 1;
+    while (done < count) {
+        size_t run = done < count - done ? done : count - done;
+        memcpy(base + done * size, base, run * size);
+        done += run;
+    }
+    if (comp->double_buffered) {
+        memcpy(__secs_comp_prev_at(comp, first), base, count * size);
+    }
+}
+
+// Make sure the pool can hold [`count`] component
+static bool __secs_comp_reserve(secs_world* world, secs_comp_list* comp, size_t count)
+{
+    if (comp->storage != SECS_STORAGE_CHUNKED) {
+        // Tag component still get a valid address
+        size_t bytes = count * comp->size_of_component;
+        if (bytes == 0) bytes = 1;
+        if (comp->double_buffered && !_secs_da_try_reserve(world, &comp->prev, bytes)) return false;
+        return _secs_da_try_reserve(world, &comp->dense, bytes);
+    }
+    size_t needed = (count + comp->per_chunk - 1) / comp->per_chunk;
+    if (!_secs_da_try_reserve(world, &comp->chunks, needed)) return false;
+    while (comp->chunks.count < needed) {
+        char* chunk = __secs_chunk_alloc(world, comp);
+        if (chunk == NULL) return false;
+        comp->chunks.items[comp->chunks.count++] = chunk;
+    }
+    return true;
+}
+
+static void __secs_comp_free(secs_world* world, secs_comp_list* comp)
+{
+    if (!__secs_cow_drop(world, &comp->refs)) {
+        // Another world still use every array of the pool
+        __secs_comp_cow(world, comp, _SECS_COW_FORGET);
+        memset(comp, 0, sizeof(secs_comp_list));
+        return;
+    }
+    rstb_da_foreach(char*, chunk, &comp->chunks) {
+        __secs_chunk_release(world, comp, *chunk);
+    }
+    _secs_da_free(world, &comp->chunks);
+    _secs_da_free(world, &comp->dense);
+    _secs_da_free(world, &comp->prev);
+    _secs_da_free(world, &comp->sparse);
+    _secs_da_free(world, &comp->entities);
+    __secs_bitset_free(world, &comp->present);
+    rstb_da_foreach(secs_entity_chunk, group, &comp->groups) {
+        _secs_da_free(world, group);
+    }
+    _secs_da_free(world, &comp->groups);
+    _secs_da_free(world, &comp->grouped);
+    _secs_da_free(world, &comp->values);
+    _secs_da_free(world, &comp->table);
+    _secs_da_free(world, &comp->index);
+    comp->indexed = 0;
+    comp->count = 0;
+}
+
+// Give back the memory that isn't needed to hold [`count`] component
+static void __secs_comp_shrink(secs_world* world, secs_comp_list* comp)
+{
+    if (world->fixed) return;
+    if (comp->storage != SECS_STORAGE_CHUNKED) {
+        size_t bytes = comp->count * comp->size_of_component;
+        _secs_da_shrink(world, &comp->dense, comp->count == 0 ? 0 : (bytes == 0 ? 1 : bytes));
+        _secs_da_shrink(world, &comp->prev, comp->count == 0 ? 0 : (bytes == 0 ? 1 : bytes));
+    } else {
+        size_t needed = (comp->count + comp->per_chunk - 1) / comp->per_chunk;
+        while (comp->chunks.count > needed) {
+            comp->chunks.count -= 1;
+            __secs_chunk_release(world, comp, comp->chunks.items[comp->chunks.count]);
+        }
+        _secs_da_shrink(world, &comp->chunks, needed);
+    }
+    _secs_da_shrink(world, &comp->entities, comp->count);
+}
+
+static void __secs_notify(secs_world* world, secs_component_mask bit, secs_observer_event event, secs_entity_id id)
+{
+    if ((world->observed[event] & bit) == 0) return;
+    __secs_observer_unshare(world);
+    rstb_da_foreach(secs_observer, observer, &world->observers) {
+        if (observer->event != event || (observer->mask & bit) == 0) continue;
+        if (!_secs_da_try_reserve(world, &observer->pending, observer->pending.count + 1)) {
+            RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+            continue;
+        }
+        observer->pending.items[observer->pending.count++] = id;
+    }
+}
+
+// Move the component along with it's entity into another slot, the old slot become garbage
+static void __secs_comp_move(secs_comp_list* comp, size_t from, size_t to)
+{
+    if (from == to) return;
+    secs_entity_id id = comp->entities.items[from];
+    memcpy(__secs_comp_at(comp, to), __secs_comp_at(comp, from), comp->size_of_component);
+    if (comp->double_buffered) {
+        memcpy(__secs_comp_prev_at(comp, to), __secs_comp_prev_at(comp, from), comp->size_of_component);
+    }
+    comp->entities.items[to] = id;
+    comp->sparse.items[id] = to;
+}
+
+static void __secs_comp_swap_bytes(char* left, char* right, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        char temp = left[i];
+        left[i] = right[i];
+        right[i] = temp;
+    }
+}
+
+static void __secs_comp_swap(secs_comp_list* comp, size_t a, size_t b)
+{
+    if (a == b) return;
+    __secs_comp_swap_bytes(__secs_comp_at(comp, a), __secs_comp_at(comp, b), comp->size_of_component);
+    if (comp->double_buffered) {
+        __secs_comp_swap_bytes(__secs_comp_prev_at(comp, a), __secs_comp_prev_at(comp, b), comp->size_of_component);
+    }
+    secs_entity_id id_a = comp->entities.items[a];
+    secs_entity_id id_b = comp->entities.items[b];
+    comp->entities.items[a] = id_b;
+    comp->entities.items[b] = id_a;
+    comp->sparse.items[id_b] = a;
+    comp->sparse.items[id_a] = b;
+}
+
+// Append the entity at the end of the pool and return the address of it's component
+// Awake entity take the first dormant slot and that dormant component go to the end
+// It will return NULL when the allocator is out of memory
+static void* __secs_comp_push(secs_world* world, size_t index, secs_entity_id id)
+{
+    secs_comp_list* comp = &world->lists.items[index];
+    if (comp->capacity > 0 && comp->count >= comp->capacity) return NULL;
+    __secs_comp_unshare(world, comp);
+    __secs_entity_unshare(world);
+    if (!_secs_da_try_reserve(world, &comp->sparse, id + 1)
+        || !_secs_da_try_reserve(world, &comp->entities, comp->count + 1)
+        || !__secs_bitset_reserve(world, &comp->present, id + 1)
+        || !__secs_comp_reserve(world, comp, comp->count + 1)
+        || !__secs_comp_own(world, comp, comp->hot, comp->count + 1 - comp->hot)) {
+        return NULL;
+    }
+    size_t slot = comp->count;
+    if (!__secs_bitset_test(&world->dormant, id)) {
+        __secs_comp_move(comp, comp->hot, comp->count);
+        slot = comp->hot++;
+        __secs_bitset_set(&comp->present, id);
+    }
+    comp->count += 1;
+    comp->sparse.items[id] = slot;
+    comp->entities.items[slot] = id;
+    // Nothing happened in the previous frame yet
+    if (comp->double_buffered) memset(__secs_comp_prev_at(comp, slot), 0, comp->size_of_component);
+    world->mask.items[id] |= _secs_comp_map[index];
+    __secs_notify(world, _secs_comp_map[index], SECS_ON_ADD, id);
+    return __secs_comp_at(comp, slot);
+}
+
+// Append many entity at once, every array only reserved once. It return the index of the first one
+// or `_SECS_NO_BIT` when the allocator is out of memory
+static size_t __secs_comp_push_many(secs_world* world, size_t index, const secs_entity_id* ids, size_t count)
+{
+    secs_comp_list* comp = &world->lists.items[index];
+    secs_entity_id id_range = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (ids[i] + 1 > id_range) id_range = ids[i] + 1;
+    }
+    if (comp->capacity > 0 && comp->count + count > comp->capacity) return _SECS_NO_BIT;
+    __secs_comp_unshare(world, comp);
+    __secs_entity_unshare(world);
+    if (!_secs_da_try_reserve(world, &comp->sparse, id_range)
+        || !_secs_da_try_reserve(world, &comp->entities, comp->count + count)
+        || !__secs_bitset_reserve(world, &comp->present, id_range)
+        || !__secs_comp_reserve(world, comp, comp->count + count)
+        || !__secs_comp_own(world, comp, comp->hot, comp->count + count - comp->hot)) {
+        return _SECS_NO_BIT;
+    }
+    // Make room in front of the dormant component
+    size_t cold = comp->count - comp->hot;
+    size_t moved = cold < count ? cold : count;
+    for (size_t i = 0; i < moved; i++) {
+        __secs_comp_move(comp, comp->hot + i, comp->count + count - moved + i);
+    }
+    size_t first = comp->hot;
+    secs_component_mask bit = _secs_comp_map[index];
+    if (comp->double_buffered) memset(__secs_comp_prev_at(comp, first), 0, count * comp->size_of_component);
+    for (size_t i = 0; i < count; i++) {
+        RSECS_ASSERT((world->mask.items[ids[i]] & bit) == 0 && "Entity already has the component");
+        RSECS_ASSERT(!__secs_bitset_test(&world->dormant, ids[i]) && "Entity is dormant");
+        comp->sparse.items[ids[i]] = first + i;
+        comp->entities.items[first + i] = ids[i];
+        __secs_bitset_set(&comp->present, ids[i]);
+        world->mask.items[ids[i]] |= bit;
+        __secs_notify(world, bit, SECS_ON_ADD, ids[i]);
+    }
+    comp->hot += count;
+    comp->count += count;
+    return first;
+}
+
+// Fill the hole with the last awake component, then fill that hole with the last dormant one
+static void __secs_comp_erase(secs_world* world, size_t index, secs_entity_id id)
+{
+    secs_comp_list* comp = &world->lists.items[index];
+    __secs_comp_unshare(world, comp);
+    __secs_entity_unshare(world);
+    size_t slot = comp->sparse.items[id];
+    if (comp->shared) {
+        __secs_group_remove(comp, __secs_shared_handle(comp, slot), id);
+    }
+    if (comp->key_size > 0) {
+        __secs_index_remove(comp, id);
+    }
+    __secs_notify(world, _secs_comp_map[index], SECS_ON_REMOVE, id);
+    if (!__secs_comp_own(world, comp, slot, 1) || !__secs_comp_own(world, comp, comp->hot - (slot < comp->hot), 1)) {
+        RSECS_ASSERT(0 && "Buy more RAM lol");
+    }
+    if (slot < comp->hot) {
+        comp->hot -= 1;
+        __secs_comp_move(comp, comp->hot, slot);
+        slot = comp->hot;
+    }
+    __secs_comp_move(comp, comp->count - 1, slot);
+    comp->sparse.items[id] = 0;
+    comp->count -= 1;
+    __secs_bitset_clear(&comp->present, id);
+    world->mask.items[id] &= ~_secs_comp_map[index];
+}
+
+// Reorder the pool by entity id, rename the entity if [`remap`] is not NULL, then give back excess memory
+static void __secs_comp_compact(secs_world* world, secs_comp_list* comp, const secs_entity_id* remap)
+{
+    __secs_comp_unshare(world, comp);
+    if (comp->count == 0) {
+        _secs_da_shrink(world, &comp->sparse, 0);
+        __secs_bitset_shrink(world, &comp->present, 0);
+        __secs_comp_shrink(world, comp);
+        rstb_da_foreach(secs_entity_chunk, group, &comp->groups) {
+            _secs_da_shrink(world, group, 0);
+        }
+        _secs_da_shrink(world, &comp->grouped, 0);
+        __secs_index_rebuild(world, comp);
+        return;
+    }
+
+    if (!__secs_comp_own(world, comp, 0, comp->count)) {
+        RSECS_ASSERT(0 && "Buy more RAM lol");
+    }
+    // Entity id is bounded so walking the sparse array give the sorted order, the awake and dormant part sorted on their own.
+    // Every slot before [`sorted`] is final so the entity is always swapped from behind, nothing is allocated so it work in fixed world too
+    size_t sorted = 0;
+    for (int dormant = 0; dormant < 2; dormant++) {
+        for (size_t id = 0; id < comp->sparse.capacity; id++) {
+            size_t slot = comp->sparse.items[id];
+            if (slot >= comp->count || comp->entities.items[slot] != id || (slot >= comp->hot) != dormant) continue;
+            __secs_comp_swap(comp, slot, sorted);
+            sorted += 1;
+        }
+    }
+    RSECS_ASSERT(sorted == comp->count && "Component pool is corrupted");
+
+    size_t id_range = 0;
+    memset(comp->sparse.items, 0, comp->sparse.capacity * sizeof(secs_entity_id));
+    __secs_bitset_reset(&comp->present);
+    for (size_t i = 0; i < comp->count; i++) {
+        secs_entity_id id = remap ? remap[comp->entities.items[i]] : comp->entities.items[i];
+        comp->entities.items[i] = id;
+        comp->sparse.items[id] = i;
+        if (i < comp->hot) __secs_bitset_set(&comp->present, id);
+        if (id + 1 > id_range) id_range = id + 1;
+    }
+    _secs_da_shrink(world, &comp->sparse, id_range);
+    __secs_bitset_shrink(world, &comp->present, id_range);
+    __secs_comp_shrink(world, comp);
+    if (comp->shared) {
+        // Renamed entity only move toward lower id so the position map already cover it
+        rstb_da_foreach(secs_entity_chunk, group, &comp->groups) {
+            group->count = 0;
+        }
+        for (size_t i = 0; i < comp->count; i++) {
+            __secs_group_add(comp, __secs_shared_handle(comp, i), comp->entities.items[i]);
+        }
+        rstb_da_foreach(secs_entity_chunk, group, &comp->groups) {
+            _secs_da_shrink(world, group, group->count);
+        }
+        _secs_da_shrink(world, &comp->grouped, id_range);
+    }
+    if (comp->key_size > 0) {
+        __secs_index_rebuild(world, comp);
+    }
+}
+
+/// --------------------------------
+/// INFO : Shared component
+/// --------------------------------
+
+static void __secs_shared_table_insert(secs_comp_list* comp, secs_shared_id handle)
+{
+    size_t i = __secs_hash(comp->values.items + handle * comp->value_size, comp->value_size) % comp->table.capacity;
+    while (comp->table.items[i] != 0) {
+        i = (i + 1) % comp->table.capacity;
+    }
+    comp->table.items[i] = handle + 1;
+}
+
+// Keep the table at most half full, the old table is kept when there is no memory for the new one
+static bool __secs_shared_table_grow(secs_world* world, secs_comp_list* comp, size_t count)
+{
+    if (count * 2 <= comp->table.capacity) return true;
+    secs_index_chunk table = {0};
+    if (!_secs_da_try_reserve(world, &table, count * 2)) return false;
+    _secs_da_free(world, &comp->table);
+    comp->table = table;
+    for (secs_shared_id handle = 0; handle < comp->groups.count; handle++) {
+        __secs_shared_table_insert(comp, handle);
+    }
+    return true;
+}
+
+// Forget every value interned after the first [`count`], used to undo insert or merge that doesn't fit
+static void __secs_shared_truncate(secs_world* world, secs_comp_list* comp, size_t count)
+{
+    if (comp->groups.count <= count) return;
+    while (comp->groups.count > count) {
+        comp->groups.count -= 1;
+        _secs_da_free(world, &comp->groups.items[comp->groups.count]);
+    }
+    comp->values.count = count * comp->value_size;
+    memset(comp->table.items, 0, comp->table.capacity * sizeof(size_t));
+    for (secs_shared_id handle = 0; handle < count; handle++) {
+        __secs_shared_table_insert(comp, handle);
+    }
+}
+
+// Point the entity into the interned value, attaching the component if it doesn't have it yet
+// It return false when the value couldn't be interned or fixed world is full, the entity is left as it is
+static bool __secs_shared_attach(secs_world* world, size_t index, secs_entity_id id, secs_shared_id handle)
+{
+    if (handle == SECS_SHARED_NONE) return false;
+    secs_comp_list* comp = &world->lists.items[index];
+    __secs_comp_unshare(world, comp);
+    bool attached = (world->mask.items[id] & _secs_comp_map[index]) != 0;
+    if (!__secs_group_reserve(world, comp, handle, 1, id + 1)
+        || (attached && !__secs_comp_own(world, comp, comp->sparse.items[id], 1))) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return false;
+    }
+    secs_shared_id* slot = NULL;
+    if (attached) {
+        slot = __secs_comp_at(comp, comp->sparse.items[id]);
+        __secs_group_remove(comp, *slot, id);
+    } else {
+        slot = __secs_comp_push(world, index, id);
+        if (slot == NULL) {
+            RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+            return false;
+        }
+    }
+    *slot = handle;
+    __secs_group_add(comp, handle, id);
+    return true;
+}
+
+/// --------------------------------
+/// INFO : Hierarchy
+/// --------------------------------
+
+static secs_entity_id __secs_link(secs_entity_chunk* links, secs_entity_id id)
+{
+    return id < links->capacity ? links->items[id] : 0;
+}
+
+static bool __secs_hierarchy_reserve(secs_world* world, size_t count)
+{
+    secs_hierarchy* hierarchy = &world->hierarchy;
+    // Fixed world take every link and the order at the first use so parenting and rebuilding never allocate again
+    if (world->fixed) count = world->max_entities;
+    return _secs_da_try_reserve(world, &hierarchy->parent, count)
+        && _secs_da_try_reserve(world, &hierarchy->first_child, count)
+        && _secs_da_try_reserve(world, &hierarchy->next_sibling, count)
+        && _secs_da_try_reserve(world, &hierarchy->prev_sibling, count)
+        && (!world->fixed || _secs_da_try_reserve(world, &hierarchy->order, count));
+}
+
+static bool __secs_hierarchy_linked(secs_hierarchy* hierarchy, secs_entity_id id)
+{
+    return __secs_link(&hierarchy->parent, id) != 0 || __secs_link(&hierarchy->first_child, id) != 0;
+}
+
+// Take the entity out of it's parent children list, the arrays must cover [`id`]
+static void __secs_hierarchy_detach(secs_hierarchy* hierarchy, secs_entity_id id)
+{
+    secs_entity_id parent = hierarchy->parent.items[id];
+    if (parent == 0) return;
+    secs_entity_id next = hierarchy->next_sibling.items[id];
+    secs_entity_id prev = hierarchy->prev_sibling.items[id];
+    if (prev != 0) {
+        hierarchy->next_sibling.items[prev - 1] = next;
+    } else {
+        hierarchy->first_child.items[parent - 1] = next;
+    }
+    if (next != 0) hierarchy->prev_sibling.items[next - 1] = prev;
+    hierarchy->parent.items[id] = 0;
+    hierarchy->next_sibling.items[id] = 0;
+    hierarchy->prev_sibling.items[id] = 0;
+}
+
+static void __secs_hierarchy_attach(secs_hierarchy* hierarchy, secs_entity_id id, secs_entity_id parent)
+{
+    secs_entity_id first = hierarchy->first_child.items[parent];
+    hierarchy->parent.items[id] = parent + 1;
+    hierarchy->next_sibling.items[id] = first;
+    hierarchy->prev_sibling.items[id] = 0;
+    if (first != 0) hierarchy->prev_sibling.items[first - 1] = id + 1;
+    hierarchy->first_child.items[parent] = id + 1;
+}
+
+// Cut every link of the entity, it's children become root
+// Entity without any link isn't inside the order so despawning it doesn't need a rebuild
+static void __secs_hierarchy_unlink(secs_world* world, secs_entity_id id)
+{
+    secs_hierarchy* hierarchy = &world->hierarchy;
+    if (!__secs_hierarchy_linked(hierarchy, id)) return;
+    __secs_hierarchy_unshare(world);
+    hierarchy->dirty = true;
+    __secs_hierarchy_detach(hierarchy, id);
+    secs_entity_id child = hierarchy->first_child.items[id];
+    while (child != 0) {
+        secs_entity_id next = hierarchy->next_sibling.items[child - 1];
+        hierarchy->parent.items[child - 1] = 0;
+        hierarchy->next_sibling.items[child - 1] = 0;
+        hierarchy->prev_sibling.items[child - 1] = 0;
+        child = next;
+    }
+    hierarchy->first_child.items[id] = 0;
+}
+
+// Breadth-first walk from every root that has children, the order itself is the queue
+// Every pool is then reordered the same way so the hierarchy query walk the component forward
+// It return false when fixed world can't hold the order
+static bool __secs_hierarchy_rebuild(secs_world* world)
+{
+    __secs_hierarchy_unshare(world);
+    secs_hierarchy* hierarchy = &world->hierarchy;
+    size_t linked = 0;
+    for (secs_entity_id id = 0; id < hierarchy->parent.capacity && id < world->mask.count; id++) {
+        if (__secs_hierarchy_linked(hierarchy, id)) linked += 1;
+    }
+    if (!_secs_da_try_reserve(world, &hierarchy->order, linked)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return false;
+    }
+    hierarchy->order.count = 0;
+    for (secs_entity_id id = 0; id < hierarchy->parent.capacity && id < world->mask.count; id++) {
+        if (hierarchy->parent.items[id] != 0 || hierarchy->first_child.items[id] == 0) continue;
+        hierarchy->order.items[hierarchy->order.count++] = id;
+    }
+    secs_component_mask participating = 0;
+    for (size_t i = 0; i < hierarchy->order.count; i++) {
+        secs_entity_id id = hierarchy->order.items[i];
+        if (!__secs_bitset_test(&world->dormant, id)) participating |= world->mask.items[id];
+        secs_entity_id child = hierarchy->first_child.items[id];
+        while (child != 0) {
+            hierarchy->order.items[hierarchy->order.count++] = child - 1;
+            child = hierarchy->next_sibling.items[child - 1];
+        }
+    }
+    hierarchy->dirty = false;
+
+    // Same as the co-owned pool of [`secs_sort_comp`], awake entity of the hierarchy is moved to the front in order
+    for (size_t index = 1; index < world->lists.count; index++) {
+        if ((participating & _secs_comp_map[index]) == 0) continue;
+        secs_comp_list* comp = &world->lists.items[index];
+        // The order is still right without it, it's only slower to walk
+        if (!__secs_comp_own(world, comp, 0, comp->hot)) continue;
+        size_t next = 0;
+        for (size_t i = 0; i < hierarchy->order.count; i++) {
+            secs_entity_id id = hierarchy->order.items[i];
+            if ((world->mask.items[id] & _secs_comp_map[index]) == 0 || __secs_bitset_test(&world->dormant, id)) continue;
+            __secs_comp_swap(comp, comp->sparse.items[id], next++);
+        }
+    }
+    return true;
+}
+
+static void __secs_hierarchy_free(secs_world* world)
+{
+    secs_hierarchy* hierarchy = &world->hierarchy;
+    if (!__secs_cow_drop(world, &hierarchy->refs)) {
+        __secs_hierarchy_cow(world, _SECS_COW_FORGET);
+        *hierarchy = (secs_hierarchy) { .dirty = true };
+        return;
+    }
+    _secs_da_free(world, &hierarchy->parent);
+    _secs_da_free(world, &hierarchy->first_child);
+    _secs_da_free(world, &hierarchy->next_sibling);
+    _secs_da_free(world, &hierarchy->prev_sibling);
+    _secs_da_free(world, &hierarchy->order);
+    hierarchy->dirty = true;
+}
+
+// Rename every link, [`remap`] only move entity toward lower id so it can be done in place
+static void __secs_hierarchy_remap(secs_world* world, const secs_entity_id* remap, size_t old_count)
+{
+    __secs_hierarchy_unshare(world);
+    secs_entity_chunk* links[] = {
+        &world->hierarchy.parent,
+        &world->hierarchy.first_child,
+        &world->hierarchy.next_sibling,
+        &world->hierarchy.prev_sibling,
+    };
+    for (size_t l = 0; l < sizeof(links) / sizeof(links[0]); l++) {
+        secs_entity_chunk* link = links[l];
+        size_t count = old_count < link->capacity ? old_count : link->capacity;
+        // Entity past the capacity has no link but it's new slot might still hold the previous owner link
+        for (secs_entity_id id = 0; id < old_count; id++) {
+            if (remap[id] == SECS_ENTITY_NONE || remap[id] >= link->capacity) continue;
+            secs_entity_id value = __secs_link(link, id);
+            link->items[remap[id]] = value == 0 ? 0 : remap[value - 1] + 1;
+        }
+        for (secs_entity_id id = world->mask.count; id < count; id++) {
+            link->items[id] = 0;
+        }
+    }
+    world->hierarchy.dirty = true;
+}
+
+/// --------------------------------
+/// INFO : Sorting
+/// --------------------------------
+
+typedef struct __secs_sort_item {
+    uint64_t    key;
+    size_t      slot;
+} __secs_sort_item;
+
+// Turn the key into unsigned integer that keep the same order
+static uint64_t __secs_sort_key(const char* data, secs_sort_key type)
+{
+    switch (type) {
+        case SECS_SORT_U32: { uint32_t v; memcpy(&v, data, 4); return v; }
+        case SECS_SORT_I32: { uint32_t v; memcpy(&v, data, 4); return v ^ 0x80000000u; }
+        case SECS_SORT_F32: { uint32_t v; memcpy(&v, data, 4); return (v & 0x80000000u) ? ~v : v | 0x80000000u; }
+        case SECS_SORT_U64: { uint64_t v; memcpy(&v, data, 8); return v; }
+        case SECS_SORT_I64: { uint64_t v; memcpy(&v, data, 8); return v ^ 0x8000000000000000ull; }
+        case SECS_SORT_F64: { uint64_t v; memcpy(&v, data, 8); return (v & 0x8000000000000000ull) ? ~v : v | 0x8000000000000000ull; }
+    }
+    return 0;
+}
+
+// Least significant byte first, the byte that every key share is skipped
+static void __secs_sort_radix(__secs_sort_item* items, __secs_sort_item* temp, size_t count, size_t bytes)
+{
+    for (size_t shift = 0; shift < bytes * 8; shift += 8) {
+        size_t offsets[256] = {0};
+        for (size_t i = 0; i < count; i++) {
+            offsets[(items[i].key >> shift) & 0xFF] += 1;
+        }
+        if (offsets[(items[0].key >> shift) & 0xFF] == count) continue;
+        size_t total = 0;
+        for (size_t b = 0; b < 256; b++) {
+            size_t n = offsets[b];
+            offsets[b] = total;
+            total += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            temp[offsets[(items[i].key >> shift) & 0xFF]++] = items[i];
+        }
+        memcpy(items, temp, count * sizeof(__secs_sort_item));
+    }
+}
+
+static void __secs_sort_insertion(__secs_sort_item* items, size_t count)
+{
+    for (size_t i = 1; i < count; i++) {
+        __secs_sort_item item = items[i];
+        size_t j = i;
+        while (j > 0 && items[j - 1].key > item.key) {
+            items[j] = items[j - 1];
+            j -= 1;
+        }
+        items[j] = item;
+    }
+}
+
+// Put the component of slot `items[i].slot` into slot `i` by following every cycle of the permutation
+// The pool must be owned already, [`temp`] hold two component so the previous side of double buffered pool follow the same cycle
+static void __secs_sort_apply(secs_comp_list* comp, __secs_sort_item* items, size_t count, char* temp)
+{
+    size_t size = comp->size_of_component;
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].slot == i) continue;
+        memcpy(temp, __secs_comp_at(comp, i), size);
+        if (comp->double_buffered) memcpy(temp + size, __secs_comp_prev_at(comp, i), size);
+        secs_entity_id temp_id = comp->entities.items[i];
+        size_t hole = i;
+        while (items[hole].slot != i) {
+            size_t from = items[hole].slot;
+            __secs_comp_move(comp, from, hole);
+            items[hole].slot = hole;
+            hole = from;
+        }
+        memcpy(__secs_comp_at(comp, hole), temp, size);
+        if (comp->double_buffered) memcpy(__secs_comp_prev_at(comp, hole), temp + size, size);
+        comp->entities.items[hole] = temp_id;
+        comp->sparse.items[temp_id] = hole;
+        items[hole].slot = hole;
+    }
+}
+
+static size_t __secs_get_comp_from_bitmask(secs_component_mask mask)
+{
+    int low = 0;
+    int high = (sizeof(_secs_comp_map)/sizeof(_secs_comp_map[0])) - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (_secs_comp_map[mid] == mask) {
+            return mid;
+        } else if (_secs_comp_map[mid] < mask) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    RSECS_ASSERT(0 && "UNREACHABLE");
+    return 0;
+}
+
+RSECS_DEF void secs_init_world(secs_world* world)
+{
+    secs_init_world_with_allocator(world, secs_default_allocator());
+}
+
+RSECS_DEF void secs_init_world_with_allocator(secs_world* world, secs_allocator allocator)
+{
+    memset(world, 0, sizeof(secs_world));
+    world->component_mask = 1;
+    world->allocator = allocator;
+    world->hierarchy.dirty = true;
+}
+
+RSECS_DEF bool secs_init_world_fixed(secs_world* world, void* buffer, size_t size, size_t max_entities)
+{
+    RSECS_ASSERT(buffer && max_entities > 0 && "Fixed world need a buffer and entity limit");
+    secs_init_world_with_allocator(world, (secs_allocator) {0});
+    secs_arena_init(&world->fixed_arena, buffer, size);
+    world->allocator = secs_arena_allocator(&world->fixed_arena);
+    world->fixed = true;
+    world->max_entities = max_entities;
+    return _secs_da_try_reserve(world, &world->mask, max_entities)
+        && __secs_bitset_reserve(world, &world->dead, max_entities)
+        && __secs_bitset_reserve(world, &world->dormant, max_entities);
+}
+
+RSECS_DEF size_t secs_world_memory_usage(secs_world* world)
+{
+    return world->bytes_allocated;
+}
+
+RSECS_DEF size_t secs_world_id_range(secs_world* world)
+{
+    return world->mask.count;
+}
+
+RSECS_DEF void secs_world_compact(secs_world* world, secs_entity_id* remap)
+{
+    __secs_entity_unshare(world);
+    __secs_hierarchy_unshare(world);
+    if (remap != NULL) {
+        size_t old_count = world->mask.count;
+        size_t living = 0;
+        for (size_t id = 0; id < world->mask.count; id++) {
+            if (__secs_bitset_test(&world->dead, id)) {
+                remap[id] = SECS_ENTITY_NONE;
+                continue;
+            }
+            remap[id] = living;
+            world->mask.items[living] = world->mask.items[id];
+            // Moving the bit toward lower id never overwrite bit that isn't moved yet
+            if (__secs_bitset_test(&world->dormant, id)) {
+                __secs_bitset_clear(&world->dormant, id);
+                __secs_bitset_set(&world->dormant, living);
+            }
+            living += 1;
+        }
+        world->mask.count = living;
+        __secs_bitset_reset(&world->dead);
+        __secs_hierarchy_remap(world, remap, old_count);
+        // Buffered entity is renamed too, the despawned one is dropped
+        __secs_observer_unshare(world);
+        rstb_da_foreach(secs_observer, observer, &world->observers) {
+            size_t kept = 0;
+            for (size_t i = 0; i < observer->pending.count; i++) {
+                secs_entity_id id = observer->pending.items[i];
+                if (id < old_count && remap[id] != SECS_ENTITY_NONE) observer->pending.items[kept++] = remap[id];
+            }
+            observer->pending.count = kept;
+        }
+    }
+
+    rstb_da_foreach(secs_comp_list, comp, &world->lists) {
+        __secs_comp_compact(world, comp, remap);
+    }
+    _secs_da_shrink(world, &world->mask, world->mask.count);
+    __secs_bitset_shrink(world, &world->dead, world->mask.count);
+    __secs_bitset_shrink(world, &world->dormant, world->mask.count);
+    _secs_da_shrink(world, &world->hierarchy.parent, world->mask.count);
+    _secs_da_shrink(world, &world->hierarchy.first_child, world->mask.count);
+    _secs_da_shrink(world, &world->hierarchy.next_sibling, world->mask.count);
+    _secs_da_shrink(world, &world->hierarchy.prev_sibling, world->mask.count);
+    _secs_da_shrink(world, &world->hierarchy.order, 0);
+    world->hierarchy.dirty = true;
+}
+
+// Check that fixed world can take every entity of [`src`] and reserve what the merge allocate,
+// the value that is interned here is forgotten again if something doesn't fit so [`dst`] is left as it is
+static bool __secs_merge_reserve(secs_world* dst, secs_world* src, size_t living)
+{
+    if (dst->dead.count + dst->max_entities - dst->mask.count < living) return false;
+    if (src->hierarchy.parent.capacity > 0 && !__secs_hierarchy_reserve(dst, dst->max_entities)) return false;
+    for (size_t index = 1; index < src->lists.count; index++) {
+        if (dst->lists.items[index].count + src->lists.items[index].count > dst->lists.items[index].capacity) return false;
+    }
+
+    size_t interned[64] = {0};
+    bool fit = true;
+    for (size_t index = 1; index < src->lists.count && fit; index++) {
+        secs_comp_list* from = &src->lists.items[index];
+        secs_comp_list* comp = &dst->lists.items[index];
+        interned[index] = comp->groups.count;
+        if (!comp->shared) continue;
+        for (secs_shared_id handle = 0; handle < from->groups.count && fit; handle++) {
+            size_t members = from->groups.items[handle].count;
+            if (members == 0) continue;
+            secs_shared_id target = secs_intern_comp(dst, _secs_comp_map[index], from->values.items + handle * from->value_size);
+            fit = target != SECS_SHARED_NONE && __secs_group_reserve(dst, comp, target, members, dst->max_entities);
+        }
+    }
+    for (size_t index = 1; index < src->lists.count && !fit; index++) {
+        if (dst->lists.items[index].shared) __secs_shared_truncate(dst, &dst->lists.items[index], interned[index]);
+    }
+    return fit;
+}
+
+RSECS_DEF bool secs_world_merge(secs_world* dst, secs_world* src, secs_entity_id* remap)
+{
+    RSECS_ASSERT(dst != src && "World can't be merged into itself");
+    RSECS_ASSERT(src->lists.count <= dst->lists.count && "Staging world has component that isn't registered");
+    // Temporary array come from [`src`] so it never eat the buffer of fixed world, it's freed in reverse order
+    secs_entity_chunk owned_remap = {0};
+    secs_entity_chunk ids = {0};
+    size_t largest = 0;
+    for (size_t index = 1; index < src->lists.count; index++) {
+        if (src->lists.items[index].count > largest) largest = src->lists.items[index].count;
+    }
+    bool fit = (remap != NULL || _secs_da_try_reserve(src, &owned_remap, src->mask.count))
+        && _secs_da_try_reserve(src, &ids, largest)
+        && (!dst->fixed || __secs_merge_reserve(dst, src, src->mask.count - src->dead.count));
+    if (!fit) {
+        RSECS_ASSERT((dst->fixed || src->fixed) && "Buy more RAM lol");
+        _secs_da_free(src, &ids);
+        _secs_da_free(src, &owned_remap);
+        return false;
+    }
+    if (remap == NULL) remap = owned_remap.items;
+    for (secs_entity_id id = 0; id < src->mask.count; id++) {
+        remap[id] = __secs_bitset_test(&src->dead, id) ? SECS_ENTITY_NONE : secs_spawn(dst);
+    }
+
+    // Everything is attached as awake and the dormant one is put to sleep at the end
+    for (size_t index = 1; index < src->lists.count; index++) {
+        secs_comp_list* from = &src->lists.items[index];
+        secs_comp_list* comp = &dst->lists.items[index];
+        RSECS_ASSERT(from->value_size == comp->value_size && from->shared == comp->shared && "Staging world register different component");
+        if (from->count == 0) continue;
+        if (comp->shared) {
+            for (size_t slot = 0; slot < from->count; slot++) {
+                const void* value = from->values.items + __secs_shared_handle(from, slot) * from->value_size;
+                if (!__secs_shared_attach(dst, index, remap[from->entities.items[slot]], secs_intern_comp(dst, _secs_comp_map[index], value))) {
+                    RSECS_ASSERT(0 && "Buy more RAM lol");
+                }
+            }
+            continue;
+        }
+        for (size_t slot = 0; slot < from->count; slot++) {
+            ids.items[slot] = remap[from->entities.items[slot]];
+        }
+        size_t first = __secs_comp_push_many(dst, index, ids.items, from->count);
+        RSECS_ASSERT(first != _SECS_NO_BIT && "Buy more RAM lol");
+        // Contiguous pool is a single run, chunked one is copied chunk by chunk
+        for (size_t done = 0; done < from->count;) {
+            size_t run = from->count - done;
+            if (from->storage == SECS_STORAGE_CHUNKED && run > from->per_chunk - done % from->per_chunk) {
+                run = from->per_chunk - done % from->per_chunk;
+            }
+            __secs_comp_write(comp, first + done, __secs_comp_at(from, done), run);
+            done += run;
+        }
+        if (comp->double_buffered && from->double_buffered) {
+            memcpy(__secs_comp_prev_at(comp, first), from->prev.items, from->count * comp->size_of_component);
+        }
+        __secs_index_add_many(dst, comp, ids.items, from->count);
+    }
+
+    for (secs_entity_id id = 0; id < src->mask.count; id++) {
+        if (remap[id] == SECS_ENTITY_NONE) continue;
+        // Attaching put the child in front of it's sibling, so walk them backward to keep the order
+        secs_entity_id child = __secs_link(&src->hierarchy.first_child, id);
+        while (child != 0 && __secs_link(&src->hierarchy.next_sibling, child - 1) != 0) {
+            child = __secs_link(&src->hierarchy.next_sibling, child - 1);
+        }
+        for (; child != 0; child = __secs_link(&src->hierarchy.prev_sibling, child - 1)) {
+            secs_set_parent(dst, remap[child - 1], remap[id]);
+        }
+        if (__secs_bitset_test(&src->dormant, id)) secs_sleep(dst, remap[id]);
+    }
+    _secs_da_free(src, &ids);
+    _secs_da_free(src, &owned_remap);
+    return true;
+}
+
+RSECS_DEF void secs_world_fork(secs_world* parent, secs_world* child)
+{
+    RSECS_ASSERT(!parent->spawning && "Close the spawn window before forking");
+    RSECS_ASSERT(!parent->fixed && "Fixed world keep it's allocator inside itself, it can't be forked");
+    secs_init_world_with_allocator(child, parent->allocator);
+    child->component_mask = parent->component_mask;
+    memcpy(child->observed, parent->observed, sizeof(child->observed));
+    // Nothing is copied here, both world point into the same array until one of them write into it
+    __secs_cow_share(parent, &parent->entity_refs);
+    child->mask = parent->mask;
+    child->dead = parent->dead;
+    child->dormant = parent->dormant;
+    child->entity_refs = parent->entity_refs;
+    __secs_entity_cow(child, _SECS_COW_ADOPT);
+
+    _secs_da_clone(child, &child->lists, &parent->lists);
+    for (size_t index = 0; index < parent->lists.count; index++) {
+        secs_comp_list* from = &parent->lists.items[index];
+        secs_comp_list* comp = &child->lists.items[index];
+        // Once the directory is copied both world has to copy the chunk before writing into it
+        from->forked = from->forked || from->chunks.count > 0;
+        __secs_cow_share(parent, &from->refs);
+        *comp = *from;
+        __secs_comp_cow(child, comp, _SECS_COW_ADOPT);
+    }
+
+    _secs_da_clone(child, &child->prefabs, &parent->prefabs);
+    for (size_t i = 0; i < parent->prefabs.count; i++) {
+        _secs_da_clone(child, &child->prefabs.items[i].data, &parent->prefabs.items[i].data);
+    }
+    __secs_cow_share(parent, &parent->hierarchy.refs);
+    child->hierarchy = parent->hierarchy;
+    __secs_hierarchy_cow(child, _SECS_COW_ADOPT);
+    __secs_cow_share(parent, &parent->event_refs);
+    child->events = parent->events;
+    child->event_refs = parent->event_refs;
+    __secs_event_cow(child, _SECS_COW_ADOPT);
+    __secs_cow_share(parent, &parent->observer_refs);
+    child->observers = parent->observers;
+    child->observer_refs = parent->observer_refs;
+    __secs_observer_cow(child, _SECS_COW_ADOPT);
+}
+
+RSECS_DEF secs_component_mask secs_register_component(secs_world* world, size_t size_component)
+{
+    return secs_register_component_desc(world, (secs_component_desc) { .size = size_component });
+}
+
+RSECS_DEF secs_component_mask secs_register_component_desc(secs_world* world, secs_component_desc desc)
+{
+    secs_component_mask temp = world->component_mask;
+    size_t index = __secs_get_comp_from_bitmask(temp);
+    if (!_secs_da_try_reserve(world, &world->lists, index + 1)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return 0;
+    }
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT((!desc.shared || desc.size > 0) && "Tag component can't be shared");
+    RSECS_ASSERT((desc.index_size == 0 || (!desc.shared && desc.index_offset + desc.index_size <= desc.size)) && "Index key must be inside non shared component");
+    RSECS_ASSERT((!desc.double_buffered || (desc.storage == SECS_STORAGE_CONTIGUOUS && !desc.shared && desc.index_size == 0)) && "Double buffered component must be contiguous, not shared and not indexed");
+    comp->shared = desc.shared;
+    comp->double_buffered = desc.double_buffered;
+    comp->key_offset = desc.index_offset;
+    comp->key_size = desc.index_size;
+    comp->value_size = desc.size;
+    comp->size_of_component = desc.shared ? sizeof(secs_shared_id) : desc.size;
+    comp->storage = desc.storage;
+    comp->per_chunk = comp->size_of_component == 0 || comp->size_of_component > SECS_CHUNK_SIZE ? 1 : SECS_CHUNK_SIZE / comp->size_of_component;
+    if (world->fixed) {
+        comp->capacity = desc.capacity > 0 && desc.capacity < world->max_entities ? desc.capacity : world->max_entities;
+        if (!_secs_da_try_reserve(world, &comp->sparse, world->max_entities)
+            || !_secs_da_try_reserve(world, &comp->entities, comp->capacity)
+            || !__secs_bitset_reserve(world, &comp->present, world->max_entities)
+            || !__secs_comp_reserve(world, comp, comp->capacity)
+            || (desc.shared && !_secs_da_try_reserve(world, &comp->grouped, world->max_entities))
+            || (desc.index_size > 0 && !_secs_da_try_reserve(world, &comp->index, comp->capacity * 2))) {
+            memset(comp, 0, sizeof(secs_comp_list));
+            return 0;
+        }
+    }
+    world->lists.count = index + 1;
+    world->component_mask = world->component_mask << 1;
+    return temp;
+}
+
+RSECS_DEF void secs_free_world(secs_world* world)
+{
+    // Array that a fork still use is only forgotten, the last world using it free it
+    if (__secs_cow_drop(world, &world->entity_refs)) {
+        _secs_da_free(world, &world->mask);
+        __secs_bitset_free(world, &world->dead);
+        __secs_bitset_free(world, &world->dormant);
+    } else {
+        __secs_entity_cow(world, _SECS_COW_FORGET);
+        world->mask = (secs_comp_mask_chunk) {0};
+        world->dead = (secs_bitset) {0};
+        world->dormant = (secs_bitset) {0};
+    }
+    rstb_da_foreach(secs_comp_list, x, &world->lists) {
+        __secs_comp_free(world, x);
+    }
+    _secs_da_free(world, &world->lists);
+    rstb_da_foreach(secs_prefab, x, &world->prefabs) {
+        _secs_da_free(world, &x->data);
+    }
+    _secs_da_free(world, &world->prefabs);
+    __secs_hierarchy_free(world);
+    if (__secs_cow_drop(world, &world->event_refs)) {
+        rstb_da_foreach(secs_event_channel, x, &world->events) {
+            _secs_da_free(world, &x->buffer);
+        }
+        _secs_da_free(world, &world->events);
+    } else {
+        __secs_event_cow(world, _SECS_COW_FORGET);
+        world->events = (secs_event_chunk) {0};
+    }
+    if (__secs_cow_drop(world, &world->observer_refs)) {
+        rstb_da_foreach(secs_observer, x, &world->observers) {
+            _secs_da_free(world, &x->pending);
+        }
+        _secs_da_free(world, &world->observers);
+    } else {
+        __secs_observer_cow(world, _SECS_COW_FORGET);
+        world->observers = (secs_observer_chunk) {0};
+    }
+    _secs_da_free(world, &world->spawn_window);
+    world->spawning = false;
+}
+
+RSECS_DEF void secs_reset_world(secs_world* world)
+{
+    __secs_entity_unshare(world);
+    __secs_hierarchy_unshare(world);
+    __secs_event_unshare(world);
+    __secs_observer_unshare(world);
+    secs_entity_chunk* links[] = {
+        &world->hierarchy.parent,
+        &world->hierarchy.first_child,
+        &world->hierarchy.next_sibling,
+        &world->hierarchy.prev_sibling,
+    };
+    for (size_t l = 0; l < sizeof(links) / sizeof(links[0]); l++) {
+        if (links[l]->items) memset(links[l]->items, 0, links[l]->capacity * sizeof(secs_entity_id));
+    }
+    world->hierarchy.dirty = true;
+    rstb_da_foreach(secs_event_channel, x, &world->events) {
+        x->head = 0;
+        x->tail = 0;
+        x->mark = 0;
+    }
+    rstb_da_foreach(secs_observer, x, &world->observers) {
+        x->pending.count = 0;
+    }
+    world->spawn_window.count = 0;
+    world->spawn_cursor = 0;
+    world->spawning = false;
+    world->mask.count = 0;
+    __secs_bitset_reset(&world->dead);
+    __secs_bitset_reset(&world->dormant);
+    rstb_da_foreach(secs_comp_list, x, &world->lists) {
+        __secs_comp_unshare(world, x);
+        x->count = 0;
+        x->hot = 0;
+        x->sparse.count = 0;
+        __secs_bitset_reset(&x->present);
+        rstb_da_foreach(secs_entity_chunk, group, &x->groups) {
+            group->count = 0;
+        }
+        if (x->index.items) memset(x->index.items, 0, x->index.capacity * sizeof(size_t));
+        x->indexed = 0;
+    }
+}
+
+RSECS_DEF secs_entity_id secs_spawn(secs_world* world)
+{
+    RSECS_ASSERT(!world->spawning && "Spawn window is open, use secs_spawn_concurrent until secs_spawn_end");
+    __secs_entity_unshare(world);
+    size_t dead = __secs_bitset_first(&world->dead);
+    if (dead != _SECS_NO_BIT) {
+        __secs_bitset_clear(&world->dead, dead);
+        world->mask.items[dead] = 0;
+        return dead;
+    }
+    if (world->fixed && world->mask.count >= world->max_entities) return SECS_ENTITY_NONE;
+    secs_entity_id id = world->mask.count;
+    _secs_da_reserve(world, &world->mask, id + 1);
+    if (!__secs_bitset_reserve(world, &world->dead, id + 1)) {
+        RSECS_ASSERT(0 && "Buy more RAM lol");
+    }
+    world->mask.items[id] = 0;
+    world->mask.count += 1;
+    return id;
+}
+
+// Give back the trailing dead id so the world can shrink
+static void __secs_world_trim(secs_world* world)
+{
+    while (world->mask.count > 0 && __secs_bitset_test(&world->dead, world->mask.count - 1)) {
+        __secs_bitset_clear(&world->dead, world->mask.count - 1);
+        world->mask.count -= 1;
+    }
+}
+
+RSECS_DEF void secs_spawn_begin(secs_world* world, size_t count)
+{
+    RSECS_ASSERT(!world->spawning && "Spawn window is already open");
+    __secs_entity_unshare(world);
+    world->spawn_window.count = 0;
+    world->spawn_cursor = 0;
+    _secs_da_reserve(world, &world->spawn_window, count);
+    while (world->spawn_window.count < count) {
+        size_t dead = __secs_bitset_first(&world->dead);
+        if (dead == _SECS_NO_BIT) break;
+        __secs_bitset_clear(&world->dead, dead);
+        world->mask.items[dead] = 0;
+        world->spawn_window.items[world->spawn_window.count++] = dead;
+    }
+    // Fresh id is at the back so the one nobody took can be trimmed
+    size_t fresh = count - world->spawn_window.count;
+    if (world->fixed && fresh > world->max_entities - world->mask.count) fresh = world->max_entities - world->mask.count;
+    _secs_da_reserve(world, &world->mask, world->mask.count + fresh);
+    if (!__secs_bitset_reserve(world, &world->dead, world->mask.count + fresh)) {
+        RSECS_ASSERT(0 && "Buy more RAM lol");
+    }
+    for (size_t i = 0; i < fresh; i++) {
+        world->mask.items[world->mask.count] = 0;
+        world->spawn_window.items[world->spawn_window.count++] = world->mask.count++;
+    }
+    world->spawning = true;
+}
+
+RSECS_DEF size_t secs_spawn_concurrent_many(secs_world* world, size_t count, secs_entity_id* ids)
+{
+    RSECS_ASSERT(world->spawning && "Spawn window is not open, call secs_spawn_begin first");
+    size_t first = RSECS_ATOMIC_ADD(&world->spawn_cursor, count);
+    if (first >= world->spawn_window.count) return 0;
+    size_t taken = world->spawn_window.count - first < count ? world->spawn_window.count - first : count;
+    memcpy(ids, world->spawn_window.items + first, taken * sizeof(secs_entity_id));
+    return taken;
+}
+
+RSECS_DEF secs_entity_id secs_spawn_concurrent(secs_world* world)
+{
+    secs_entity_id id = SECS_ENTITY_NONE;
+    secs_spawn_concurrent_many(world, 1, &id);
+    return id;
+}
+
+RSECS_DEF void secs_spawn_end(secs_world* world)
+{
+    RSECS_ASSERT(world->spawning && "Spawn window is not open, call secs_spawn_begin first");
+    __secs_entity_unshare(world);
+    for (size_t i = world->spawn_cursor; i < world->spawn_window.count; i++) {
+        __secs_bitset_set(&world->dead, world->spawn_window.items[i]);
+    }
+    __secs_world_trim(world);
+    world->spawn_window.count = 0;
+    world->spawn_cursor = 0;
+    world->spawning = false;
+}
+
+RSECS_DEF void secs_despawn(secs_world* world, secs_entity_id id)
+{
+    RSECS_ASSERT(world->mask.count > id && "Entity is not found");
+    __secs_entity_unshare(world);
+    for (size_t i = 1; i < world->lists.count; i++) {
+        if (world->mask.items[id] & _secs_comp_map[i]) {
+            __secs_comp_erase(world, i, id);
+        }
+    }
+    world->mask.items[id] = 0;
+    __secs_hierarchy_unlink(world, id);
+    __secs_bitset_clear(&world->dormant, id);
+    __secs_bitset_set(&world->dead, id);
+    __secs_world_trim(world);
+}
+
+RSECS_DEF void secs_despawn_many(secs_world* world, const secs_entity_id* ids, size_t count)
+{
+    secs_component_mask touched = 0;
+    for (size_t i = 0; i < count; i++) {
+        RSECS_ASSERT(world->mask.count > ids[i] && "Entity is not found");
+        touched |= world->mask.items[ids[i]];
+    }
+    __secs_entity_unshare(world);
+
+    // Visit every pool once for every victim instead of every victim visiting every pool
+    for (size_t index = 1; index < world->lists.count; index++) {
+        secs_component_mask bit = _secs_comp_map[index];
+        if ((touched & bit) == 0) continue;
+        for (size_t i = 0; i < count; i++) {
+            if (world->mask.items[ids[i]] & bit) {
+                __secs_comp_erase(world, index, ids[i]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        world->mask.items[ids[i]] = 0;
+        __secs_hierarchy_unlink(world, ids[i]);
+        __secs_bitset_clear(&world->dormant, ids[i]);
+        __secs_bitset_set(&world->dead, ids[i]);
+    }
+    __secs_world_trim(world);
+}
+
+RSECS_DEF size_t secs_despawn_query(secs_world* world, secs_query query)
+{
+    secs_entity_chunk victims = {0};
+    secs_query_iterator it = secs_query_iter(world, query);
+    while (secs_query_iter_next(&it)) {
+        _secs_da_append(world, &victims, secs_query_iter_current(&it));
+    }
+    size_t count = victims.count;
+    secs_despawn_many(world, victims.items, victims.count);
+    _secs_da_free(world, &victims);
+    return count;
+}
+
+RSECS_DEF bool secs_set_parent(secs_world* world, secs_entity_id child, secs_entity_id parent)
+{
+    return secs_set_parent_many(world, &child, 1, parent);
+}
+
+RSECS_DEF bool secs_set_parent_many(secs_world* world, const secs_entity_id* children, size_t count, secs_entity_id parent)
+{
+    RSECS_ASSERT((parent == SECS_ENTITY_NONE || world->mask.count > parent) && "Entity is not found");
+    __secs_hierarchy_unshare(world);
+    if (!__secs_hierarchy_reserve(world, world->mask.count)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return false;
+    }
+    secs_hierarchy* hierarchy = &world->hierarchy;
+    for (size_t i = 0; i < count; i++) {
+        secs_entity_id child = children[i];
+        RSECS_ASSERT(world->mask.count > child && "Entity is not found");
+        __secs_hierarchy_detach(hierarchy, child);
+        if (parent == SECS_ENTITY_NONE) continue;
+        for (secs_entity_id ancestor = parent + 1; ancestor != 0; ancestor = hierarchy->parent.items[ancestor - 1]) {
+            RSECS_ASSERT(ancestor - 1 != child && "Entity can't be parented to it's own descendant");
+        }
+        __secs_hierarchy_attach(hierarchy, child, parent);
+    }
+    hierarchy->dirty = true;
+    return true;
+}
+
+RSECS_DEF secs_entity_id secs_get_parent(secs_world* world, secs_entity_id id)
+{
+    RSECS_ASSERT(world->mask.count > id && "Entity is not found");
+    return __secs_link(&world->hierarchy.parent, id) - 1;
+}
+
+RSECS_DEF void secs_despawn_tree(secs_world* world, secs_entity_id root)
+{
+    RSECS_ASSERT(world->mask.count > root && "Entity is not found");
+    secs_entity_chunk victims = {0};
+    _secs_da_append(world, &victims, root);
+    for (size_t i = 0; i < victims.count; i++) {
+        secs_entity_id child = __secs_link(&world->hierarchy.first_child, victims.items[i]);
+        while (child != 0) {
+            _secs_da_append(world, &victims, child - 1);
+            child = world->hierarchy.next_sibling.items[child - 1];
+        }
+    }
+    secs_despawn_many(world, victims.items, victims.count);
+    _secs_da_free(world, &victims);
+}
+
+RSECS_DEF void secs_sleep(secs_world* world, secs_entity_id id)
+{
+    RSECS_ASSERT(world->mask.count > id && "Entity is not found");
+    if (secs_is_dormant(world, id)) return;
+    __secs_entity_unshare(world);
+    if (!__secs_bitset_reserve(world, &world->dormant, world->mask.count)) {
+        RSECS_ASSERT(0 && "Buy more RAM lol");
+    }
+    for (size_t index = 1; index < world->lists.count; index++) {
+        if ((world->mask.items[id] & _secs_comp_map[index]) == 0) continue;
+        secs_comp_list* comp = &world->lists.items[index];
+        comp->hot -= 1;
+        if (!__secs_comp_own(world, comp, comp->sparse.items[id], 1) || !__secs_comp_own(world, comp, comp->hot, 1)) {
+            RSECS_ASSERT(0 && "Buy more RAM lol");
+        }
+        __secs_comp_swap(comp, comp->sparse.items[id], comp->hot);
+        __secs_bitset_clear(&comp->present, id);
+    }
+    __secs_bitset_set(&world->dormant, id);
+}
+
+RSECS_DEF void secs_wake(secs_world* world, secs_entity_id id)
+{
+    RSECS_ASSERT(world->mask.count > id && "Entity is not found");
+    if (!secs_is_dormant(world, id)) return;
+    __secs_entity_unshare(world);
+    for (size_t index = 1; index < world->lists.count; index++) {
+        if ((world->mask.items[id] & _secs_comp_map[index]) == 0) continue;
+        secs_comp_list* comp = &world->lists.items[index];
+        if (!__secs_comp_own(world, comp, comp->sparse.items[id], 1) || !__secs_comp_own(world, comp, comp->hot, 1)) {
+            RSECS_ASSERT(0 && "Buy more RAM lol");
+        }
+        __secs_comp_swap(comp, comp->sparse.items[id], comp->hot);
+        comp->hot += 1;
+        __secs_bitset_set(&comp->present, id);
+    }
+    __secs_bitset_clear(&world->dormant, id);
+}
+
+RSECS_DEF bool secs_is_dormant(secs_world* world, secs_entity_id id)
+{
+    RSECS_ASSERT(world->mask.count > id && "Entity is not found");
+    return __secs_bitset_test(&world->dormant, id);
+}
+
+RSECS_DEF secs_prefab_id secs_register_prefab(secs_world* world, secs_entity_id entity_id)
+{
+    RSECS_ASSERT(world->mask.count > entity_id && "Entity is not found");
+    secs_prefab prefab = { .mask = world->mask.items[entity_id] };
+    size_t size = 0;
+    for (size_t index = 1; index < world->lists.count; index++) {
+        if (prefab.mask & _secs_comp_map[index]) size += world->lists.items[index].size_of_component;
+    }
+    // Reserved once so the template is the last allocation and fixed world get it back when the list is full
+    if (!_secs_da_try_reserve(world, &prefab.data, size)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return SECS_PREFAB_NONE;
+    }
+    for (size_t index = 1; index < world->lists.count; index++) {
+        if ((prefab.mask & _secs_comp_map[index]) == 0) continue;
+        secs_comp_list* comp = &world->lists.items[index];
+        // Shared component keep the handle since the value is already stored once
+        memcpy(prefab.data.items + prefab.data.count, __secs_comp_at(comp, comp->sparse.items[entity_id]), comp->size_of_component);
+        prefab.data.count += comp->size_of_component;
+    }
+    if (!_secs_da_try_reserve(world, &world->prefabs, world->prefabs.count + 1)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        _secs_da_free(world, &prefab.data);
+        return SECS_PREFAB_NONE;
+    }
+    world->prefabs.items[world->prefabs.count++] = prefab;
+    return world->prefabs.count - 1;
+}
+
+RSECS_DEF bool secs_instantiate(secs_world* world, secs_prefab_id prefab_id, size_t count, secs_entity_id* ids)
+{
+    RSECS_ASSERT(prefab_id < world->prefabs.count && "Prefab is not found");
+    if (world->fixed) {
+        if (world->dead.count + world->max_entities - world->mask.count < count) return false;
+        secs_prefab* prefab = &world->prefabs.items[prefab_id];
+        size_t offset = 0;
+        for (size_t index = 1; index < world->lists.count; index++) {
+            if ((prefab->mask & _secs_comp_map[index]) == 0) continue;
+            secs_comp_list* comp = &world->lists.items[index];
+            if (comp->count + count > comp->capacity) return false;
+            // Shared component keep the handle in the template
+            secs_shared_id handle = 0;
+            if (comp->shared) memcpy(&handle, prefab->data.items + offset, sizeof(secs_shared_id));
+            if (comp->shared && !__secs_group_reserve(world, comp, handle, count, world->max_entities)) return false;
+            offset += comp->size_of_component;
+        }
+    }
+    secs_entity_chunk spawned = {0};
+    if (ids == NULL) {
+        if (!_secs_da_try_reserve(world, &spawned, count)) {
+            RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+            return false;
+        }
+        ids = spawned.items;
+    }
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = secs_spawn(world);
+    }
+
+    secs_prefab* prefab = &world->prefabs.items[prefab_id];
+    size_t offset = 0;
+    for (size_t index = 1; index < world->lists.count; index++) {
+        if ((prefab->mask & _secs_comp_map[index]) == 0) continue;
+        secs_comp_list* comp = &world->lists.items[index];
+        size_t first = __secs_comp_push_many(world, index, ids, count);
+        RSECS_ASSERT(first != _SECS_NO_BIT && "Buy more RAM lol");
+        __secs_comp_fill(comp, first, prefab->data.items + offset, count);
+        if (comp->shared && count > 0) {
+            secs_shared_id handle = __secs_shared_handle(comp, first);
+            if (!__secs_group_reserve(world, comp, handle, count, world->mask.count)) {
+                RSECS_ASSERT(0 && "Buy more RAM lol");
+            }
+            for (size_t i = 0; i < count; i++) {
+                __secs_group_add(comp, handle, ids[i]);
+            }
+        }
+        __secs_index_add_many(world, comp, ids, count);
+        offset += comp->size_of_component;
+    }
+    _secs_da_free(world, &spawned);
+    return true;
+}
+
+RSECS_DEF bool secs_insert_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id, void* component)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    if (index < world->lists.count && world->lists.items[index].shared) {
+        secs_comp_list* comp = &world->lists.items[index];
+        size_t interned = comp->groups.count;
+        if (__secs_shared_attach(world, index, entity_id, secs_intern_comp(world, component_id, component))) return true;
+        // The value that only came with this insert is forgotten again
+        __secs_shared_truncate(world, comp, interned);
+        return false;
+    }
+    if (index < world->lists.count && world->lists.items[index].key_size > 0) {
+        secs_comp_list* comp = &world->lists.items[index];
+        void* slot = NULL;
+        if (secs_has_comp(world, entity_id, component_id)) {
+            __secs_comp_unshare(world, comp);
+            __secs_index_remove(comp, entity_id);
+            slot = __secs_comp_get_mut(world, comp, entity_id);
+        } else {
+            slot = __secs_comp_push(world, index, entity_id);
+            if (slot == NULL) {
+                RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+                return false;
+            }
+        }
+        memcpy(slot, component, comp->size_of_component);
+        __secs_index_add(world, comp, entity_id);
+        return true;
+    }
+    // New component start the same on both side, overwriting only touch the next frame
+    bool fresh = secs_has_not_comp(world, entity_id, component_id);
+    void* slot = secs_emplace_comp(world, entity_id, component_id);
+    if (slot == NULL) return false;
+    secs_comp_list* comp = &world->lists.items[index];
+    memcpy(slot, component, comp->size_of_component);
+    if (fresh && comp->double_buffered) {
+        memcpy(__secs_comp_prev_at(comp, comp->sparse.items[entity_id]), component, comp->size_of_component);
+    }
+    return true;
+}
+
+RSECS_DEF void* secs_emplace_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT(!comp->shared && "Shared component can't be modified in place, insert it instead");
+    RSECS_ASSERT(comp->key_size == 0 && "Indexed component can't be modified in place, insert it instead");
+    if (secs_has_comp(world, entity_id, component_id)) {
+        return __secs_comp_get_mut(world, comp, entity_id);
+    }
+    void* slot = __secs_comp_push(world, index, entity_id);
+    RSECS_ASSERT((slot || world->fixed) && "Buy more RAM lol");
+    return slot;
+}
+
+RSECS_DEF void* secs_emplace_comp_many(secs_world* world, const secs_entity_id* ids, size_t count, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT(comp->storage == SECS_STORAGE_CONTIGUOUS && "Chunked component can't give contiguous slot");
+    RSECS_ASSERT(!comp->shared && "Shared component can't be modified in place, insert it instead");
+    RSECS_ASSERT(comp->key_size == 0 && "Indexed component can't be modified in place, insert it instead");
+    size_t first = __secs_comp_push_many(world, index, ids, count);
+    if (first == _SECS_NO_BIT) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return NULL;
+    }
+    return __secs_comp_at(comp, first);
+}
+
+RSECS_DEF bool secs_has_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    RSECS_ASSERT(world->mask.count > entity_id && "Entity is not found");
+    return (world->mask.items[entity_id] & component_id) == component_id;
+}
+
+RSECS_DEF bool secs_has_not_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    RSECS_ASSERT(world->mask.count > entity_id && "Entity is not found");
+    return (world->mask.items[entity_id] & component_id) == 0;
+}
+
+RSECS_DEF void secs_remove_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.capacity && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    if (component_id == 0 || !secs_has_comp(world, entity_id, component_id)) return;
+    __secs_comp_erase(world, index, entity_id);
+}
+
+RSECS_DEF bool secs_insert_comp_many(secs_world* world, const secs_entity_id* ids, size_t count, secs_component_mask component_id, const void* components)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    const char* data = components;
+
+    bool overwrite = comp->shared;
+    for (size_t i = 0; i < count && !overwrite; i++) {
+        RSECS_ASSERT(world->mask.count > ids[i] && "Entity is not found");
+        overwrite = (world->mask.items[ids[i]] & component_id) != 0 || __secs_bitset_test(&world->dormant, ids[i]);
+    }
+    if (overwrite) {
+        for (size_t i = 0; i < count; i++) {
+            if (!secs_insert_comp(world, ids[i], component_id, (void*)(data + i * comp->value_size))) return false;
+        }
+        return true;
+    }
+
+    size_t first = __secs_comp_push_many(world, index, ids, count);
+    if (first == _SECS_NO_BIT) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return false;
+    }
+    __secs_comp_write(comp, first, data, count);
+    __secs_index_add_many(world, comp, ids, count);
+    return true;
+}
+
+RSECS_DEF void secs_remove_comp_many(secs_world* world, const secs_entity_id* ids, size_t count, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    for (size_t i = 0; i < count; i++) {
+        RSECS_ASSERT(world->mask.count > ids[i] && "Entity is not found");
+        if (world->mask.items[ids[i]] & component_id) {
+            __secs_comp_erase(world, index, ids[i]);
+        }
+    }
+}
+
+RSECS_DEF void secs_clear_comp(secs_world* world, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    __secs_comp_unshare(world, comp);
+    __secs_entity_unshare(world);
+    for (size_t i = 0; i < comp->count; i++) {
+        secs_entity_id id = comp->entities.items[i];
+        world->mask.items[id] &= ~component_id;
+        comp->sparse.items[id] = 0;
+        __secs_bitset_clear(&comp->present, id);
+        __secs_notify(world, component_id, SECS_ON_REMOVE, id);
+    }
+    rstb_da_foreach(secs_entity_chunk, group, &comp->groups) {
+        group->count = 0;
+    }
+    if (comp->index.items) memset(comp->index.items, 0, comp->index.capacity * sizeof(size_t));
+    comp->indexed = 0;
+    comp->count = 0;
+    comp->hot = 0;
+}
+
+RSECS_DEF void* secs_get_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.capacity && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    if (!secs_has_comp(world, entity_id, component_id)) return NULL;
+
+    secs_comp_list* comp = &world->lists.items[index];
+    if (comp->sparse.capacity <= entity_id) return NULL;
+    return __secs_comp_get_mut(world, comp, entity_id);
+}
+
+RSECS_DEF const void* secs_peek_comp(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.capacity && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    if (!secs_has_comp(world, entity_id, component_id)) return NULL;
+
+    secs_comp_list* comp = &world->lists.items[index];
+    if (comp->sparse.capacity <= entity_id) return NULL;
+    return __secs_comp_get(comp, entity_id);
+}
+
+RSECS_DEF const void* secs_get_comp_prev(secs_world* world, secs_entity_id entity_id, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT(comp->double_buffered && "Component is not double buffered");
+    if (!secs_has_comp(world, entity_id, component_id)) return NULL;
+    return __secs_comp_prev_at(comp, comp->sparse.items[entity_id]);
+}
+
+RSECS_DEF void secs_swap_buffers(secs_world* world)
+{
+    rstb_da_foreach(secs_comp_list, comp, &world->lists) {
+        if (!comp->double_buffered) continue;
+        secs_comp_chunk temp = comp->dense;
+        comp->dense = comp->prev;
+        comp->prev = temp;
+    }
+}
+
+RSECS_DEF secs_shared_id secs_intern_comp(secs_world* world, secs_component_mask component_id, const void* value)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT(comp->shared && "Component is not registered as shared");
+
+    size_t size = comp->value_size;
+    if (comp->table.capacity > 0) {
+        size_t i = __secs_hash(value, size) % comp->table.capacity;
+        for (; comp->table.items[i] != 0; i = (i + 1) % comp->table.capacity) {
+            secs_shared_id handle = comp->table.items[i] - 1;
+            if (memcmp(comp->values.items + handle * size, value, size) == 0) return handle;
+        }
+    }
+
+    __secs_comp_unshare(world, comp);
+    secs_shared_id handle = comp->groups.count;
+    if (!_secs_da_try_reserve(world, &comp->values, (handle + 1) * size)
+        || !_secs_da_try_reserve(world, &comp->groups, handle + 1)
+        || !__secs_shared_table_grow(world, comp, handle + 1)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return SECS_SHARED_NONE;
+    }
+    memcpy(comp->values.items + handle * size, value, size);
+    comp->values.count += size;
+    comp->groups.items[comp->groups.count++] = (secs_entity_chunk) {0};
+    __secs_shared_table_insert(comp, handle);
+    return handle;
+}
+
+RSECS_DEF size_t secs_shared_count(secs_world* world, secs_component_mask component_id)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    return world->lists.items[index].groups.count;
+}
+
+RSECS_DEF const void* secs_shared_value(secs_world* world, secs_component_mask component_id, secs_shared_id handle)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT(handle < comp->groups.count && "Shared value is not found");
+    return comp->values.items + handle * comp->value_size;
+}
+
+
+RSECS_DEF bool secs_sort_comp(secs_world* world, secs_component_mask component_id, secs_sort_desc desc)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    size_t bytes = desc.key >= SECS_SORT_U64 ? 8 : 4;
+    RSECS_ASSERT(desc.offset + bytes <= comp->value_size && "Sort key must be inside the component");
+    size_t count = comp->hot;
+
+    // Every pool is owned before anything move so running out of memory leave them as they are
+    // Awake entity is awake in every pool so it's always inside the hot part of the co-owned pool
+    for (size_t other = 1; other < world->lists.count; other++) {
+        if (other != index && (desc.co_owned & _secs_comp_map[other]) == 0) continue;
+        secs_comp_list* owned = &world->lists.items[other];
+        if (!__secs_comp_own(world, owned, 0, owned->hot)) {
+            RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+            return false;
+        }
+    }
+
+    if (count > 1) {
+        // Single block freed right away, so arena of fixed world get every byte of it back
+        size_t items_size = count * sizeof(__secs_sort_item);
+        size_t block_size = items_size * (desc.nearly_sorted ? 1 : 2) + 2 * comp->size_of_component + 1;
+        char* block = world->allocator.alloc(world->allocator.ctx, block_size);
+        if (block == NULL) {
+            RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+            return false;
+        }
+        __secs_sort_item* items = (__secs_sort_item*)block;
+        for (size_t slot = 0; slot < count; slot++) {
+            items[slot].key = __secs_sort_key((const char*)__secs_comp_get(comp, comp->entities.items[slot]) + desc.offset, desc.key);
+            items[slot].slot = slot;
+        }
+        char* temp = block + items_size;
+        if (desc.nearly_sorted) {
+            __secs_sort_insertion(items, count);
+        } else {
+            __secs_sort_radix(items, (__secs_sort_item*)temp, count, bytes);
+            temp += items_size;
+        }
+        __secs_sort_apply(comp, items, count, temp);
+        world->allocator.free(world->allocator.ctx, block, block_size);
+    }
+
+    for (size_t other = 1; other < world->lists.count; other++) {
+        if (other == index || (desc.co_owned & _secs_comp_map[other]) == 0) continue;
+        secs_comp_list* owned = &world->lists.items[other];
+        size_t next = 0;
+        for (size_t slot = 0; slot < count; slot++) {
+            secs_entity_id id = comp->entities.items[slot];
+            if ((world->mask.items[id] & _secs_comp_map[other]) == 0) continue;
+            __secs_comp_swap(owned, owned->sparse.items[id], next++);
+        }
+    }
+    return true;
+}
+
+RSECS_DEF secs_event_id secs_register_event(secs_world* world, size_t size, size_t capacity)
+{
+    RSECS_ASSERT(capacity > 0 && "Event channel need to hold at least one event");
+    secs_event_channel channel = { .size = size, .capacity = capacity };
+    __secs_event_unshare(world);
+    // Tag event still get a valid address
+    if (!_secs_da_try_reserve(world, &channel.buffer, size * capacity == 0 ? 1 : size * capacity)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        return SECS_EVENT_NONE;
+    }
+    if (!_secs_da_try_reserve(world, &world->events, world->events.count + 1)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        _secs_da_free(world, &channel.buffer);
+        return SECS_EVENT_NONE;
+    }
+    world->events.items[world->events.count++] = channel;
+    return world->events.count - 1;
+}
+
+RSECS_DEF void* secs_emit_event(secs_world* world, secs_event_id channel_id)
+{
+    RSECS_ASSERT(channel_id < world->events.count && "Event channel is not found");
+    __secs_event_unshare(world);
+    secs_event_channel* channel = &world->events.items[channel_id];
+    if (channel->head - channel->tail == channel->capacity) {
+        channel->tail += 1;
+    }
+    void* slot = channel->buffer.items + (channel->head % channel->capacity) * channel->size;
+    channel->head += 1;
+    return slot;
+}
+
+RSECS_DEF void secs_send_event(secs_world* world, secs_event_id channel_id, const void* event)
+{
+    void* slot = secs_emit_event(world, channel_id);
+    memcpy(slot, event, world->events.items[channel_id].size);
+}
+
+RSECS_DEF secs_event_reader secs_event_reader_init(secs_world* world, secs_event_id channel_id)
+{
+    RSECS_ASSERT(channel_id < world->events.count && "Event channel is not found");
+    return (secs_event_reader) {
+        .channel = channel_id,
+        .cursor = world->events.items[channel_id].tail,
+    };
+}
+
+RSECS_DEF size_t secs_read_events(secs_world* world, secs_event_reader* reader, const void** events)
+{
+    RSECS_ASSERT(reader->channel < world->events.count && "Event channel is not found");
+    secs_event_channel* channel = &world->events.items[reader->channel];
+    if (reader->cursor < channel->tail) reader->cursor = channel->tail;
+    // The world might be reset while the reader is kept around
+    if (reader->cursor > channel->head) reader->cursor = channel->head;
+    size_t start = reader->cursor % channel->capacity;
+    size_t count = (size_t)(channel->head - reader->cursor);
+    if (count > channel->capacity - start) count = channel->capacity - start;
+    *events = channel->buffer.items + start * channel->size;
+    reader->cursor += count;
+    return count;
+}
+
+RSECS_DEF void secs_update_events(secs_world* world)
+{
+    __secs_event_unshare(world);
+    rstb_da_foreach(secs_event_channel, channel, &world->events) {
+        if (channel->tail < channel->mark) channel->tail = channel->mark;
+        channel->mark = channel->head;
+    }
+}
+
+RSECS_DEF secs_observer_id secs_register_observer(secs_world* world, secs_component_mask mask, secs_observer_event event, secs_observer_fn callback, void* user_data)
+{
+    RSECS_ASSERT(callback && "Observer need a callback");
+    secs_observer observer = {
+        .mask = mask,
+        .event = event,
+        .callback = callback,
+        .user_data = user_data,
+    };
+    __secs_observer_unshare(world);
+    // Fixed world take the whole batch up front, an entity reported more often than that in one frame is dropped
+    if (world->fixed && !_secs_da_try_reserve(world, &observer.pending, world->max_entities)) {
+        return SECS_OBSERVER_NONE;
+    }
+    if (!_secs_da_try_reserve(world, &world->observers, world->observers.count + 1)) {
+        RSECS_ASSERT(world->fixed && "Buy more RAM lol");
+        _secs_da_free(world, &observer.pending);
+        return SECS_OBSERVER_NONE;
+    }
+    world->observers.items[world->observers.count++] = observer;
+    world->observed[event] |= mask;
+    return world->observers.count - 1;
+}
+
+RSECS_DEF void secs_dispatch_observers(secs_world* world)
+{
+    __secs_observer_unshare(world);
+    // The callback might change the world so the batch is taken out of the observer first
+    for (size_t i = 0; i < world->observers.count; i++) {
+        secs_observer* observer = &world->observers.items[i];
+        if (observer->pending.count == 0) continue;
+        secs_entity_chunk batch = observer->pending;
+        observer->pending = (secs_entity_chunk) {0};
+        observer->callback(world, batch.items, batch.count, observer->user_data);
+
+        // Give the memory back so the next batch doesn't allocate, the callback might have forked the world too
+        __secs_observer_unshare(world);
+        observer = &world->observers.items[i];
+        if (observer->pending.count == 0) {
+            _secs_da_free(world, &observer->pending);
+            batch.count = 0;
+            observer->pending = batch;
+        } else {
+            _secs_da_free(world, &batch);
+        }
+    }
+}
+
+RSECS_DEF secs_entity_id secs_index_find(secs_world* world, secs_component_mask component_id, const void* key)
+{
+    size_t index = __secs_get_comp_from_bitmask(component_id);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_comp_list* comp = &world->lists.items[index];
+    RSECS_ASSERT(comp->key_size > 0 && "Component is not registered with index");
+    if (comp->index.capacity == 0) return SECS_ENTITY_NONE;
+    size_t i = __secs_hash(key, comp->key_size) % comp->index.capacity;
+    for (; comp->index.items[i] != 0; i = (i + 1) % comp->index.capacity) {
+        secs_entity_id id = comp->index.items[i] - 1;
+        if (memcmp((const char*)__secs_comp_get(comp, id) + comp->key_offset, key, comp->key_size) == 0) return id;
+    }
+    return SECS_ENTITY_NONE;
+}
+
+RSECS_DEF secs_query_iterator secs_query_iter(secs_world* world, secs_query query)
+{
+     return (secs_query_iterator) {
+        .query = query,
+        .world = world,
+        .position = (uint64_t)-1,
+    };
+}
+
+RSECS_DEF secs_query_iterator secs_query_iter_sorted(secs_world* world, secs_query query, secs_component_mask mask)
+{
+    size_t index = __secs_get_comp_from_bitmask(mask);
+    RSECS_ASSERT(index < world->lists.count && "Yo, out of bound!, please register it by using `REGISTER_COMPONENT` and use it's id it generated");
+    secs_query_iterator it = secs_query_iter(world, query);
+    it.sorted = mask;
+    return it;
+}
+
+RSECS_DEF secs_query_iterator secs_query_iter_hierarchy(secs_world* world, secs_query query)
+{
+    secs_query_iterator it = secs_query_iter(world, query);
+    // Without any link every entity is a root, so the plain order is already breadth-first
+    it.hierarchy = !world->hierarchy.dirty || __secs_hierarchy_rebuild(world);
+    return it;
+}
+
+static secs_bitset* __secs_query_bitset(secs_world* world, secs_component_mask bit)
+{
+    size_t index = __secs_ctz64(bit) + 1;
+    return index < world->lists.count ? &world->lists.items[index].present : NULL;
+}
+
+// Entity that has the shared value the query grouped by
+static secs_entity_chunk* __secs_query_group(secs_query_iterator* it)
+{
+    size_t index = __secs_ctz64(it->query.group) + 1;
+    if (index >= it->world->lists.count) return NULL;
+    secs_comp_list* comp = &it->world->lists.items[index];
+    return it->query.group_value < comp->groups.count ? &comp->groups.items[it->query.group_value] : NULL;
+}
+
+// Bit per entity in this 64 entity word that match the query
+static uint64_t __secs_query_word(secs_query_iterator* it, size_t word)
+{
+    secs_world* world = it->world;
+    uint64_t bits = ~(uint64_t)0;
+    if (it->query.has == 0) {
+        bits = ~__secs_bitset_word(&world->dead, word) & ~__secs_bitset_word(&world->dormant, word);
+    }
+    for (secs_component_mask has = it->query.has; has != 0 && bits != 0; has &= has - 1) {
+        secs_bitset* present = __secs_query_bitset(world, has);
+        bits &= present ? __secs_bitset_word(present, word) : 0;
+    }
+    for (secs_component_mask exclude = it->query.exclude; exclude != 0 && bits != 0; exclude &= exclude - 1) {
+        secs_bitset* present = __secs_query_bitset(world, exclude);
+        bits &= present ? ~__secs_bitset_word(present, word) : ~(uint64_t)0;
+    }
+    if (it->query.any != 0 && bits != 0) {
+        uint64_t any = 0;
+        for (secs_component_mask mask = it->query.any; mask != 0; mask &= mask - 1) {
+            secs_bitset* present = __secs_query_bitset(world, mask);
+            any |= present ? __secs_bitset_word(present, word) : 0;
+        }
+        bits &= any;
+    }
+    return bits;
+}
+
+// Bit per word in this 4096 entity area that might match the query
+static uint64_t __secs_query_summary(secs_query_iterator* it, size_t summary)
+{
+    uint64_t bits = ~(uint64_t)0;
+    for (secs_component_mask has = it->query.has; has != 0 && bits != 0; has &= has - 1) {
+        secs_bitset* present = __secs_query_bitset(it->world, has);
+        bits &= present ? __secs_bitset_summary(present, summary) : 0;
+    }
+    if (it->query.any != 0 && bits != 0) {
+        uint64_t any = 0;
+        for (secs_component_mask mask = it->query.any; mask != 0; mask &= mask - 1) {
+            secs_bitset* present = __secs_query_bitset(it->world, mask);
+            any |= present ? __secs_bitset_summary(present, summary) : 0;
+        }
+        bits &= any;
+    }
+    return bits;
+}
+
+// Test a single entity, used when the order is not sorted by id
+static bool __secs_query_match(secs_query_iterator* it, secs_entity_id id)
+{
+    secs_world* world = it->world;
+    if (id >= world->mask.count || __secs_bitset_test(&world->dead, id) || __secs_bitset_test(&world->dormant, id)) return false;
+    secs_component_mask mask = world->mask.items[id];
+    if ((mask & it->query.has) != it->query.has || (mask & it->query.exclude) != 0) return false;
+    if (it->query.any != 0 && (mask & it->query.any) == 0) return false;
+    if (it->query.group != 0) {
+        secs_comp_list* comp = &world->lists.items[__secs_ctz64(it->query.group) + 1];
+        if ((mask & it->query.group) == 0 || __secs_shared_handle(comp, comp->sparse.items[id]) != it->query.group_value) return false;
+    }
+    return true;
+}
+
+// Entity without any link has nothing to wait for, so it's visited after the order by walking every id
+static bool __secs_query_iter_next_hierarchy(secs_query_iterator* it)
+{
+    secs_hierarchy* hierarchy = &it->world->hierarchy;
+    while (it->cursor < hierarchy->order.count) {
+        secs_entity_id id = hierarchy->order.items[it->cursor++];
+        if (!__secs_query_match(it, id)) continue;
+        it->position = id;
+        return true;
+    }
+    while (it->cursor - hierarchy->order.count < it->world->mask.count) {
+        secs_entity_id id = it->cursor++ - hierarchy->order.count;
+        if (__secs_hierarchy_linked(hierarchy, id) || !__secs_query_match(it, id)) continue;
+        it->position = id;
+        return true;
+    }
+    return false;
+}
+
+// Walk the list from the back, changing the value of the current entity only move an entity that is already visited
+// [`cursor`] is the position of the last visited entity + 1, 0 mean it's not started yet
+static bool __secs_query_iter_next_group(secs_query_iterator* it)
+{
+    secs_entity_chunk* group = __secs_query_group(it);
+    if (group == NULL) return false;
+    size_t position = it->cursor == 0 || it->cursor - 1 > group->count ? group->count : it->cursor - 1;
+    while (position > 0) {
+        position -= 1;
+        secs_entity_id id = group->items[position];
+        if (!__secs_query_match(it, id)) continue;
+        it->cursor = position + 1;
+        it->position = id;
+        return true;
+    }
+    return false;
+}
+
+static bool __secs_query_iter_next_sorted(secs_query_iterator* it)
+{
+    secs_comp_list* comp = &it->world->lists.items[__secs_ctz64(it->sorted) + 1];
+    while (it->cursor < comp->hot) {
+        secs_entity_id id = comp->entities.items[it->cursor++];
+        if (!__secs_query_match(it, id)) continue;
+        it->position = id;
+        return true;
+    }
+    return false;
+}
+
+RSECS_DEF bool secs_query_iter_next(secs_query_iterator* it)
+{
+    if (it->done) return false;
+    if (it->hierarchy) {
+        it->done = !__secs_query_iter_next_hierarchy(it);
+        return !it->done;
+    }
+    if (it->sorted != 0) {
+        it->done = !__secs_query_iter_next_sorted(it);
+        return !it->done;
+    }
+    if (it->query.group != 0) {
+        it->done = !__secs_query_iter_next_group(it);
+        return !it->done;
+    }
+    size_t count = it->world->mask.count;
+    size_t start = it->position + 1;
+    while (start < count) {
+        size_t word = start / 64;
+        uint64_t summary = __secs_query_summary(it, word / 64) & (~(uint64_t)0 << (word % 64));
+        if (summary == 0) {
+            start = (word / 64 + 1) * 4096;
+            continue;
+        }
+        size_t first = (word / 64) * 64 + __secs_ctz64(summary);
+        if (first > word) {
+            word = first;
+            start = word * 64;
+        }
+        uint64_t bits = __secs_query_word(it, word) & (~(uint64_t)0 << (start % 64));
+        if (bits != 0) {
+            size_t id = word * 64 + __secs_ctz64(bits);
+            if (id >= count) break;
+            it->position = id;
+            return true;
+        }
+        start = (word + 1) * 64;
+    }
+    it->position = (secs_entity_id)count - 1;
+    it->done = true;
+    return false;
+}
+
+#ifdef _SECS_DEFAULT_CLOCK
+// Monotonic clock in seconds, processor time would stop while the thread is waiting
+static double __secs_clock(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#elif defined(TIME_UTC)
+    // Wall clock, it can jump when the system time is changed
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#else
+    // Strict C99 with a system header included first hide both, processor time is the last resort
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+#endif // _SECS_DEFAULT_CLOCK
+
+RSECS_DEF bool secs_query_iter_next_budget(secs_query_iterator* it, size_t max_entities, double max_seconds)
+{
+    if (!it->in_slice) {
+        it->in_slice = true;
+        it->slice_count = 0;
+#ifdef RSECS_CLOCK
+        it->slice_start = max_seconds > 0 ? RSECS_CLOCK() : 0;
+#else
+        RSECS_ASSERT(max_seconds <= 0 && "No clock on this platform, provide RSECS_CLOCK to use time budget");
+#endif
+    }
+    // Reading the clock is not free so only check it every 64 entity
+    bool out_of_budget = (max_entities > 0 && it->slice_count >= max_entities);
+#ifdef RSECS_CLOCK
+    out_of_budget = out_of_budget
+        || (max_seconds > 0 && it->slice_count > 0 && it->slice_count % 64 == 0 && RSECS_CLOCK() - it->slice_start >= max_seconds);
+#endif
+    if (out_of_budget || !secs_query_iter_next(it)) {
+        it->in_slice = false;
+        return false;
+    }
+    it->slice_count += 1;
+    return true;
+}
+
+// The iterator already know the entity is alive so only the mask is checked, no searching the component index
+RSECS_DEF void* secs_field(secs_query_iterator* it, secs_component_mask mask)
+{
+    secs_world* world = it->world;
+    if (mask == 0 || (world->mask.items[it->position] & mask) != mask) return NULL;
+    return __secs_comp_get_mut(world, &world->lists.items[__secs_ctz64(mask) + 1], it->position);
+}
+
+RSECS_DEF const void* secs_peek_field(secs_query_iterator* it, secs_component_mask mask)
+{
+    secs_world* world = it->world;
+    if (mask == 0 || (world->mask.items[it->position] & mask) != mask) return NULL;
+    return __secs_comp_get(&world->lists.items[__secs_ctz64(mask) + 1], it->position);
+}
+
+RSECS_DEF const void* secs_field_prev(secs_query_iterator* it, secs_component_mask mask)
+{
+    secs_world* world = it->world;
+    if (mask == 0 || (world->mask.items[it->position] & mask) != mask) return NULL;
+    secs_comp_list* comp = &world->lists.items[__secs_ctz64(mask) + 1];
+    RSECS_ASSERT(comp->double_buffered && "Component is not double buffered");
+    return __secs_comp_prev_at(comp, comp->sparse.items[it->position]);
+}
+
+
+#endif //RSECS_IMPLEMENTATION
+
+#ifdef RSECS_STRIP_PREFIX
+    #define INIT_WORLD(WORLD) SECS_INIT_WORLD(WORLD)
+    #define init_world_with_allocator(WORLD, ALLOCATOR) secs_init_world_with_allocator((WORLD), (ALLOCATOR))
     #define REGISTER_COMPONENT(WORLD, TYPE) SECS_REGISTER_COMPONENT(WORLD, TYPE)
+    #define REGISTER_COMPONENT_EX(WORLD, TYPE, ...) SECS_REGISTER_COMPONENT_EX(WORLD, TYPE, __VA_ARGS__)
+    #define REGISTER_EVENT(WORLD, TYPE, CAPACITY) SECS_REGISTER_EVENT(WORLD, TYPE, CAPACITY)
     #define CREATE_QUERY(...) SECS_CREATE_QUERY(__VA_ARGS__)
+    #define DECLARE_COMPONENT(TYPE, ORDER) SECS_DECLARE_COMPONENT(TYPE, ORDER)
+    #define COMP_MASK(TYPE) SECS_COMP_MASK(TYPE)
 
     #define insert_comp(WORLD, ID, MASK, ...) secs_insert_comp((WORLD), (ID), (MASK), (__VA_ARGS__))
+    #define emplace_comp(WORLD, ID, MASK) secs_emplace_comp((WORLD), (ID), (MASK))
+    #define emplace_comp_many(WORLD, IDS, COUNT, MASK) secs_emplace_comp_many((WORLD), (IDS), (COUNT), (MASK))
     #define remove_comp(WORLD, ID, MASK) secs_remove_comp((WORLD), (ID), (MASK))
+    #define insert_comp_many(WORLD, IDS, COUNT, MASK, COMPONENTS) secs_insert_comp_many((WORLD), (IDS), (COUNT), (MASK), (COMPONENTS))
+    #define remove_comp_many(WORLD, IDS, COUNT, MASK) secs_remove_comp_many((WORLD), (IDS), (COUNT), (MASK))
+    #define clear_comp(WORLD, MASK) secs_clear_comp((WORLD), (MASK))
     #define has_comp(WORLD, ID, MASK) secs_has_comp((WORLD), (ID), (MASK))
     #define has_not_comp(WORLD, ID, MASK) secs_has_not_comp((WORLD), (ID), (MASK))
     #define get_comp(WORLD, ID, MASK) secs_get_comp((WORLD), (ID), (MASK))
+    #define peek_comp(WORLD, ID, MASK) secs_peek_comp((WORLD), (ID), (MASK))
+    #define get_comp_prev(WORLD, ID, MASK) secs_get_comp_prev((WORLD), (ID), (MASK))
+    #define swap_buffers(WORLD) secs_swap_buffers((WORLD))
+    #define intern_comp(WORLD, MASK, VALUE) secs_intern_comp((WORLD), (MASK), (VALUE))
+    #define shared_count(WORLD, MASK) secs_shared_count((WORLD), (MASK))
+    #define shared_value(WORLD, MASK, HANDLE) secs_shared_value((WORLD), (MASK), (HANDLE))
+    #define index_find(WORLD, MASK, KEY) secs_index_find((WORLD), (MASK), (KEY))
+    #define send_event(WORLD, CHANNEL, ...) secs_send_event((WORLD), (CHANNEL), (__VA_ARGS__))
+    #define emit_event(WORLD, CHANNEL) secs_emit_event((WORLD), (CHANNEL))
+    #define event_reader_init(WORLD, CHANNEL) secs_event_reader_init((WORLD), (CHANNEL))
+    #define read_events(WORLD, READER, EVENTS) secs_read_events((WORLD), (READER), (EVENTS))
+    #define update_events(WORLD) secs_update_events((WORLD))
+    #define register_observer(WORLD, MASK, EVENT, CALLBACK, USER_DATA) secs_register_observer((WORLD), (MASK), (EVENT), (CALLBACK), (USER_DATA))
+    #define dispatch_observers(WORLD) secs_dispatch_observers((WORLD))
+
+    #define despawn_many(WORLD, IDS, COUNT) secs_despawn_many((WORLD), (IDS), (COUNT))
+    #define spawn_begin(WORLD, COUNT) secs_spawn_begin((WORLD), (COUNT))
+    #define spawn_concurrent(WORLD) secs_spawn_concurrent((WORLD))
+    #define spawn_concurrent_many(WORLD, COUNT, IDS) secs_spawn_concurrent_many((WORLD), (COUNT), (IDS))
+    #define spawn_end(WORLD) secs_spawn_end((WORLD))
+    #define despawn_tree(WORLD, ROOT) secs_despawn_tree((WORLD), (ROOT))
+    #define set_parent(WORLD, CHILD, PARENT) secs_set_parent((WORLD), (CHILD), (PARENT))
+    #define set_parent_many(WORLD, CHILDREN, COUNT, PARENT) secs_set_parent_many((WORLD), (CHILDREN), (COUNT), (PARENT))
+    #define get_parent(WORLD, ID) secs_get_parent((WORLD), (ID))
+    // `sleep` is left out since it clash with the POSIX one
+    #define wake(WORLD, ID) secs_wake((WORLD), (ID))
+    #define is_dormant(WORLD, ID) secs_is_dormant((WORLD), (ID))
+    #define despawn_query(WORLD, QUERY) secs_despawn_query((WORLD), (QUERY))
+    #define register_prefab(WORLD, ID) secs_register_prefab((WORLD), (ID))
+    #define instantiate(WORLD, PREFAB, COUNT, IDS) secs_instantiate((WORLD), (PREFAB), (COUNT), (IDS))
 
     #define query_iter(WORLD, QUERY) secs_query_iter((WORLD), (QUERY))
+    #define query_iter_hierarchy(WORLD, QUERY) secs_query_iter_hierarchy((WORLD), (QUERY))
+    #define query_iter_sorted(WORLD, QUERY, MASK) secs_query_iter_sorted((WORLD), (QUERY), (MASK))
+    #define sort_comp(WORLD, MASK, DESC) secs_sort_comp((WORLD), (MASK), (DESC))
     #define query_iter_next(IT) secs_query_iter_next((IT))
+    #define query_iter_next_budget(IT, MAX_ENTITIES, MAX_SECONDS) secs_query_iter_next_budget((IT), (MAX_ENTITIES), (MAX_SECONDS))
+    #define query_iter_done(IT) secs_query_iter_done(IT)
     #define query_iter_reset(IT) secs_query_iter_reset((IT))
     #define query_iter_current(IT) secs_query_iter_current(IT)
     #define field(IT, MASK) secs_field((IT), (MASK))
+    #define peek_field(IT, MASK) secs_peek_field((IT), (MASK))
+    #define field_prev(IT, MASK) secs_field_prev((IT), (MASK))
 #endif // RSECS_STRIP_PREFIX
 
 #endif // RSECS_H